@@ -30,17 +30,82 @@ SOFTWARE.
 
 //These can easily be replaced with custom libraries instead of STL
 #include <vector> //std::vector
-#include <functional> //std::function
+#include <functional> //std::function, std::less, std::greater
+#include <cstddef> //size_t
+#include <utility> //std::move, std::forward, std::pair, std::swap
+#include <iterator> //std::make_move_iterator
+#include <memory> //std::shared_ptr
+#include <new> //placement new, std::bad_alloc
+#include <type_traits> //std::enable_if, std::decay
+#include <cstring> //std::memcpy
+#include <cmath> //std::fmod, std::floor, std::fabs, std::sqrt
+#include <atomic> //std::atomic
+#include <algorithm> //std::copy, std::fill, std::min, std::max, std::push_heap, std::sort, std::stable_sort, std::merge, std::upper_bound
+// Debug switches
+// STWEEN_TRACK_ALLOCATIONS: counts storage growth inside Update(), see GetUpdateAllocations()
+// STWEEN_ASSERT_NO_UPDATE_ALLOCATIONS: same as above and asserts the count stays at 0
+// STWEEN_STATS: counters and phase timings of the last Update(), see GetStats()
+#ifdef STWEEN_ASSERT_NO_UPDATE_ALLOCATIONS
+#ifndef STWEEN_TRACK_ALLOCATIONS
+#define STWEEN_TRACK_ALLOCATIONS
+#endif
+#include <cassert> //assert
+#endif
+#ifdef STWEEN_STATS
+#include <chrono> //std::chrono::steady_clock
+#endif
+
+// Profiler zone around a phase of Update(), expands to nothing by default
+// Define it before including STween.h to attribute frame time to tweening, e.g.
+// Tracy: #define STWEEN_ZONE(name) ZoneScopedN(name)
+// Perfetto: #define STWEEN_ZONE(name) TRACE_EVENT("stween", name)
+// Each use is in its own scope: "STween::Update", "STween::Wake", "STween::Evaluate",
+// "STween::Callbacks" (per finished tween), "STween::Compact" and "STween::Resume"
+#ifndef STWEEN_ZONE
+#define STWEEN_ZONE(name)
+#endif
+
+// Define STWEEN_NO_THREADS to leave out TweenThreadPool
+#ifndef STWEEN_NO_THREADS
+#include <thread> //std::thread
+#include <mutex> //std::mutex
+#include <condition_variable> //std::condition_variable
+#endif
+
+// Bytes stored inline by TweenFunction callbacks, bigger callables are allocated
+// Define STWEEN_NO_CALLBACK_HEAP to make callables that don't fit a compile error instead
+#ifndef STWEEN_CALLBACK_CAPACITY
+#define STWEEN_CALLBACK_CAPACITY sizeof(std::function<void()>)
+#endif
+
+// SIMD lanes used by the batched easing kernels
+// Define STWEEN_NO_SIMD to only use the scalar path
+#if !defined(STWEEN_NO_SIMD) && defined(__AVX__)
+#include <immintrin.h>
+#define STWEEN_SIMD_AVX
+#elif !defined(STWEEN_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define STWEEN_SIMD_SSE2
+#elif !defined(STWEEN_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define STWEEN_SIMD_NEON
+#endif
+
+// C++20 coroutines, see TweenAwaiter
+// Define STWEEN_NO_COROUTINES to leave them out
+#if !defined(STWEEN_NO_COROUTINES) && defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine> //std::coroutine_handle
+#define STWEEN_COROUTINES
+#endif
+#endif
 
 namespace STween
 {
 
 // Available Easing functions built-in
-// *Custom easing function not supported yet
-// Function format for custom easing:
-// template<typename T> 
-// T YourEasingFunction(float position, T start, T end)
-enum EasingFunction
+// Custom easing functions are added with RegisterEasing()
+enum EasingFunction : int
 {
 	Linear,
 	QuadranticIn,
@@ -57,6 +122,582 @@ enum EasingFunction
 	BackInOut
 };
 
+namespace Detail
+{
+// Number of built-in easing functions
+const int BuiltinEasingCount = BackInOut + 1;
+
+// Lane types used to evaluate easing curves
+// float is the scalar lane, the SIMD lanes below mirror its interface
+// so every curve is written once for all of them
+inline bool LessThan(float a, float b) { return a < b; }
+inline float Select(bool mask, float a, float b) { return mask ? a : b; }
+
+#if defined(STWEEN_SIMD_AVX)
+struct FloatLanes
+{
+	static const size_t Width = 8;
+	FloatLanes() {}
+	FloatLanes(float s) : v(_mm256_set1_ps(s)) {}
+	explicit FloatLanes(__m256 x) : v(x) {}
+	static FloatLanes Load(const float* p) { return FloatLanes(_mm256_loadu_ps(p)); }
+	void Store(float* p) const { _mm256_storeu_ps(p, v); }
+	__m256 v;
+};
+inline FloatLanes operator+(FloatLanes a, FloatLanes b) { return FloatLanes(_mm256_add_ps(a.v, b.v)); }
+inline FloatLanes operator-(FloatLanes a, FloatLanes b) { return FloatLanes(_mm256_sub_ps(a.v, b.v)); }
+inline FloatLanes operator*(FloatLanes a, FloatLanes b) { return FloatLanes(_mm256_mul_ps(a.v, b.v)); }
+inline FloatLanes LessThan(FloatLanes a, FloatLanes b) { return FloatLanes(_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)); }
+inline FloatLanes Select(FloatLanes mask, FloatLanes a, FloatLanes b) { return FloatLanes(_mm256_blendv_ps(b.v, a.v, mask.v)); }
+#elif defined(STWEEN_SIMD_SSE2)
+struct FloatLanes
+{
+	static const size_t Width = 4;
+	FloatLanes() {}
+	FloatLanes(float s) : v(_mm_set1_ps(s)) {}
+	explicit FloatLanes(__m128 x) : v(x) {}
+	static FloatLanes Load(const float* p) { return FloatLanes(_mm_loadu_ps(p)); }
+	void Store(float* p) const { _mm_storeu_ps(p, v); }
+	__m128 v;
+};
+inline FloatLanes operator+(FloatLanes a, FloatLanes b) { return FloatLanes(_mm_add_ps(a.v, b.v)); }
+inline FloatLanes operator-(FloatLanes a, FloatLanes b) { return FloatLanes(_mm_sub_ps(a.v, b.v)); }
+inline FloatLanes operator*(FloatLanes a, FloatLanes b) { return FloatLanes(_mm_mul_ps(a.v, b.v)); }
+inline FloatLanes LessThan(FloatLanes a, FloatLanes b) { return FloatLanes(_mm_cmplt_ps(a.v, b.v)); }
+inline FloatLanes Select(FloatLanes mask, FloatLanes a, FloatLanes b)
+{
+	return FloatLanes(_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)));
+}
+#elif defined(STWEEN_SIMD_NEON)
+struct FloatLanes
+{
+	static const size_t Width = 4;
+	FloatLanes() {}
+	FloatLanes(float s) : v(vdupq_n_f32(s)) {}
+	explicit FloatLanes(float32x4_t x) : v(x) {}
+	static FloatLanes Load(const float* p) { return FloatLanes(vld1q_f32(p)); }
+	void Store(float* p) const { vst1q_f32(p, v); }
+	float32x4_t v;
+};
+struct FloatLanesMask
+{
+	explicit FloatLanesMask(uint32x4_t x) : v(x) {}
+	uint32x4_t v;
+};
+inline FloatLanes operator+(FloatLanes a, FloatLanes b) { return FloatLanes(vaddq_f32(a.v, b.v)); }
+inline FloatLanes operator-(FloatLanes a, FloatLanes b) { return FloatLanes(vsubq_f32(a.v, b.v)); }
+inline FloatLanes operator*(FloatLanes a, FloatLanes b) { return FloatLanes(vmulq_f32(a.v, b.v)); }
+inline FloatLanesMask LessThan(FloatLanes a, FloatLanes b) { return FloatLanesMask(vcltq_f32(a.v, b.v)); }
+inline FloatLanes Select(FloatLanesMask mask, FloatLanes a, FloatLanes b) { return FloatLanes(vbslq_f32(mask.v, a.v, b.v)); }
+#endif
+
+// Easing curves
+// Each one maps a position in [0, 1] to the eased factor applied to (end - start)
+template<class V> struct LinearCurve
+{
+	static V Evaluate(V t) { return t; }
+};
+
+template<class V> struct QuadInCurve
+{
+	static V Evaluate(V t) { return t * t; }
+};
+
+template<class V> struct QuadOutCurve
+{
+	static V Evaluate(V t) { return t * (V(2.0f) - t); }
+};
+
+template<class V> struct QuadInOutCurve
+{
+	static V Evaluate(V t)
+	{
+		V p = t * V(2.0f);
+		V q = p - V(1.0f);
+		return Select(LessThan(p, V(1.0f)),
+			V(0.5f) * p * p,
+			V(-0.5f) * (q * (q - V(2.0f)) - V(1.0f)));
+	}
+};
+
+template<class V> struct CubicInCurve
+{
+	static V Evaluate(V t) { return t * t * t; }
+};
+
+template<class V> struct CubicOutCurve
+{
+	static V Evaluate(V t)
+	{
+		V p = t - V(1.0f);
+		return p * p * p + V(1.0f);
+	}
+};
+
+template<class V> struct CubicInOutCurve
+{
+	static V Evaluate(V t)
+	{
+		V p = t * V(2.0f);
+		V q = p - V(2.0f);
+		return Select(LessThan(p, V(1.0f)),
+			V(0.5f) * p * p * p,
+			V(0.5f) * (q * q * q + V(2.0f)));
+	}
+};
+
+template<class V> struct QuintInCurve
+{
+	static V Evaluate(V t)
+	{
+		V t2 = t * t;
+		return t2 * t2 * t;
+	}
+};
+
+template<class V> struct QuintOutCurve
+{
+	static V Evaluate(V t)
+	{
+		V p = t - V(1.0f);
+		V p2 = p * p;
+		return p2 * p2 * p + V(1.0f);
+	}
+};
+
+template<class V> struct QuintInOutCurve
+{
+	static V Evaluate(V t)
+	{
+		V p = t * V(2.0f);
+		V q = p - V(2.0f);
+		V p2 = p * p;
+		V q2 = q * q;
+		return Select(LessThan(p, V(1.0f)),
+			V(0.5f) * (p2 * p2 * p),
+			V(0.5f) * (q2 * q2 * q + V(2.0f)));
+	}
+};
+
+template<class V> struct BackInCurve
+{
+	static V Evaluate(V t)
+	{
+		const float s = 1.70158f;
+		return t * t * (V(s + 1) * t - V(s));
+	}
+};
+
+template<class V> struct BackOutCurve
+{
+	static V Evaluate(V t)
+	{
+		const float s = 1.70158f;
+		V p = t - V(1.0f);
+		return p * p * (V(s + 1) * p + V(s)) + V(1.0f);
+	}
+};
+
+template<class V> struct BackInOutCurve
+{
+	static V Evaluate(V t)
+	{
+		const float s = 1.70158f * 1.525f;
+		V p = t * V(2.0f);
+		V q = p - V(2.0f);
+		return Select(LessThan(p, V(1.0f)),
+			V(0.5f) * (p * p * (V(s + 1) * p - V(s))),
+			V(0.5f) * (q * q * (V(s + 1) * q + V(s)) + V(2.0f)));
+	}
+};
+
+// Maps an EasingFunction known at compile time to its curve
+template<EasingFunction E> struct CurveFor { template<class V> using Curve = LinearCurve<V>; };
+template<> struct CurveFor<QuadranticIn> { template<class V> using Curve = QuadInCurve<V>; };
+template<> struct CurveFor<QuadranticOut> { template<class V> using Curve = QuadOutCurve<V>; };
+template<> struct CurveFor<QuadranticInOut> { template<class V> using Curve = QuadInOutCurve<V>; };
+template<> struct CurveFor<CubicIn> { template<class V> using Curve = CubicInCurve<V>; };
+template<> struct CurveFor<CubicOut> { template<class V> using Curve = CubicOutCurve<V>; };
+template<> struct CurveFor<CubicInOut> { template<class V> using Curve = CubicInOutCurve<V>; };
+template<> struct CurveFor<QuintIn> { template<class V> using Curve = QuintInCurve<V>; };
+template<> struct CurveFor<QuintOut> { template<class V> using Curve = QuintOutCurve<V>; };
+template<> struct CurveFor<QuintInOut> { template<class V> using Curve = QuintInOutCurve<V>; };
+template<> struct CurveFor<BackIn> { template<class V> using Curve = BackInCurve<V>; };
+template<> struct CurveFor<BackOut> { template<class V> using Curve = BackOutCurve<V>; };
+template<> struct CurveFor<BackInOut> { template<class V> using Curve = BackInOutCurve<V>; };
+
+// Entry of the custom easing table
+// 'easeRange' evaluates in SIMD lanes, null for curves registered as plain function pointers
+struct CustomEasing
+{
+	float (*ease)(float t);
+	void (*easeRange)(float* t, size_t count);
+};
+
+// Dense table of the curves given to RegisterEasing()
+// Custom EasingFunction values index it after the built-in ones
+inline std::vector<CustomEasing>& CustomEasings()
+{
+	static std::vector<CustomEasing> easings;
+	return easings;
+}
+
+// Number of valid EasingFunction values, built-in and custom
+inline size_t EasingCount()
+{
+	return BuiltinEasingCount + CustomEasings().size();
+}
+
+// Returns the custom curve of 'easing', null for built-in or unknown values
+inline const CustomEasing* CustomEasingOf(EasingFunction easing)
+{
+	const std::vector<CustomEasing>& easings = CustomEasings();
+	const size_t index = static_cast<size_t>(static_cast<unsigned int>(easing)) - BuiltinEasingCount;
+	return static_cast<unsigned int>(easing) >= BuiltinEasingCount && index < easings.size() ? &easings[index] : nullptr;
+}
+
+// Evaluates a single position
+inline float Ease(EasingFunction easing, float t)
+{
+	switch (easing)
+	{
+	case EasingFunction::QuadranticIn: return QuadInCurve<float>::Evaluate(t);
+	case EasingFunction::QuadranticOut: return QuadOutCurve<float>::Evaluate(t);
+	case EasingFunction::QuadranticInOut: return QuadInOutCurve<float>::Evaluate(t);
+	case EasingFunction::CubicIn: return CubicInCurve<float>::Evaluate(t);
+	case EasingFunction::CubicOut: return CubicOutCurve<float>::Evaluate(t);
+	case EasingFunction::CubicInOut: return CubicInOutCurve<float>::Evaluate(t);
+	case EasingFunction::QuintIn: return QuintInCurve<float>::Evaluate(t);
+	case EasingFunction::QuintOut: return QuintOutCurve<float>::Evaluate(t);
+	case EasingFunction::QuintInOut: return QuintInOutCurve<float>::Evaluate(t);
+	case EasingFunction::BackIn: return BackInCurve<float>::Evaluate(t);
+	case EasingFunction::BackOut: return BackOutCurve<float>::Evaluate(t);
+	case EasingFunction::BackInOut: return BackInOutCurve<float>::Evaluate(t);
+	default:
+		if (const CustomEasing* custom = CustomEasingOf(easing))
+			return custom->ease(t);
+		return LinearCurve<float>::Evaluate(t);
+	}
+}
+
+// Evaluates a contiguous range of positions in place
+// Uses the widest SIMD lanes available, the remainder is done one by one
+template<template<class> class Curve> void EaseRange(float* t, size_t count)
+{
+	size_t i = 0;
+#if defined(STWEEN_SIMD_AVX) || defined(STWEEN_SIMD_SSE2) || defined(STWEEN_SIMD_NEON)
+	for (; i + FloatLanes::Width <= count; i += FloatLanes::Width)
+	{
+		Curve<FloatLanes>::Evaluate(FloatLanes::Load(t + i)).Store(t + i);
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		t[i] = Curve<float>::Evaluate(t[i]);
+	}
+}
+
+// Evaluates a contiguous range of positions sharing the same easing function
+inline void EaseBatch(EasingFunction easing, float* t, size_t count)
+{
+	switch (easing)
+	{
+	case EasingFunction::QuadranticIn: EaseRange<QuadInCurve>(t, count); break;
+	case EasingFunction::QuadranticOut: EaseRange<QuadOutCurve>(t, count); break;
+	case EasingFunction::QuadranticInOut: EaseRange<QuadInOutCurve>(t, count); break;
+	case EasingFunction::CubicIn: EaseRange<CubicInCurve>(t, count); break;
+	case EasingFunction::CubicOut: EaseRange<CubicOutCurve>(t, count); break;
+	case EasingFunction::CubicInOut: EaseRange<CubicInOutCurve>(t, count); break;
+	case EasingFunction::QuintIn: EaseRange<QuintInCurve>(t, count); break;
+	case EasingFunction::QuintOut: EaseRange<QuintOutCurve>(t, count); break;
+	case EasingFunction::QuintInOut: EaseRange<QuintInOutCurve>(t, count); break;
+	case EasingFunction::BackIn: EaseRange<BackInCurve>(t, count); break;
+	case EasingFunction::BackOut: EaseRange<BackOutCurve>(t, count); break;
+	case EasingFunction::BackInOut: EaseRange<BackInOutCurve>(t, count); break;
+	default:
+		if (const CustomEasing* custom = CustomEasingOf(easing))
+		{
+			if (custom->easeRange)
+			{
+				custom->easeRange(t, count);
+			}
+			else
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					t[i] = custom->ease(t[i]);
+				}
+			}
+		}
+		break;
+	}
+}
+}
+
+// Adds a custom easing curve and returns the EasingFunction to pass to Easing()
+// A curve only maps the position in [0, 1] to an eased factor,
+// the lerp between start and end stays in STween so custom curves are batched like the built-in ones
+// float SmoothStep(float t) { return t * t * (3.0f - 2.0f * t); }
+// const EasingFunction smoothStep = RegisterEasing(&SmoothStep);
+// tweens.From(&x).To(1.0f).Time(1.0f).Easing(smoothStep);
+// *Register at startup, the table must not change while tweens are updated
+inline EasingFunction RegisterEasing(float (*curve)(float t))
+{
+	Detail::CustomEasing easing = { curve, nullptr };
+	Detail::CustomEasings().push_back(easing);
+	return static_cast<EasingFunction>(Detail::EasingCount() - 1);
+}
+
+// Same as above for curves written like the built-in ones, evaluated in SIMD lanes when batched
+// template<class V> struct SmoothStepCurve { static V Evaluate(V t) { return t * t * (V(3.0f) - V(2.0f) * t); } };
+// const EasingFunction smoothStep = RegisterEasing<SmoothStepCurve>();
+template<template<class> class Curve> EasingFunction RegisterEasing()
+{
+	Detail::CustomEasing easing = { &Curve<float>::Evaluate, &Detail::EaseRange<Curve> };
+	Detail::CustomEasings().push_back(easing);
+	return static_cast<EasingFunction>(Detail::EasingCount() - 1);
+}
+
+// Easing curves baked into evenly spaced samples
+// Evaluation is one lookup and one lerp, whatever the cost of the curve
+// The error shrinks with the square of the resolution, at the default 256 samples
+// every built-in curve stays within 1e-4 of the exact one (QuintInOut being the worst)
+// MaxError() returns the error measured while baking
+// *Positions are clamped to [0, 1] where the exact curves would extrapolate
+// Custom curves registered before construction are baked too, later ones use the exact curve
+// *Baking allocates, build it once at startup and share it between managers
+class SampledEasing
+{
+public:
+	// 'resolution' samples per curve, at least 2
+	explicit SampledEasing(size_t resolution = 256);
+
+	// Evaluates a single position
+	float Evaluate(EasingFunction easing, float t) const;
+	// Evaluates a contiguous range of positions in place
+	void EvaluateRange(EasingFunction easing, float* t, size_t count) const;
+	size_t GetResolution() const;
+	// Largest difference with the exact curve found while baking
+	float MaxError(EasingFunction easing) const;
+	// Largest difference over every curve
+	float MaxError() const;
+
+private:
+	// Returns the first sample of the curve, null if it wasn't baked
+	const float* SamplesOf(EasingFunction easing) const;
+
+	std::vector<float> m_samples;
+	std::vector<float> m_maxError;
+	size_t m_resolution;
+	// resolution - 1, maps a position to a sample
+	float m_scale;
+};
+
+inline SampledEasing::SampledEasing(size_t resolution)
+	:m_resolution(resolution > 2 ? resolution : 2),
+	m_scale(static_cast<float>((resolution > 2 ? resolution : 2) - 1))
+{
+	const size_t easingCount = Detail::EasingCount();
+	m_samples.resize(easingCount * m_resolution);
+	m_maxError.resize(easingCount, 0.0f);
+
+	for (size_t e = 0; e < easingCount; ++e)
+	{
+		const EasingFunction easing = static_cast<EasingFunction>(e);
+		float* samples = &m_samples[e * m_resolution];
+		for (size_t i = 0; i < m_resolution; ++i)
+		{
+			samples[i] = Detail::Ease(easing, static_cast<float>(i) / m_scale);
+		}
+
+		// Measure between the samples, where the lerp is furthest from the curve
+		const int probes = 8;
+		float maxError = 0.0f;
+		for (size_t i = 0; i + 1 < m_resolution; ++i)
+		{
+			for (int k = 1; k < probes; ++k)
+			{
+				const float t = (static_cast<float>(i) + static_cast<float>(k) / probes) / m_scale;
+				const float error = Evaluate(easing, t) - Detail::Ease(easing, t);
+				maxError = std::max(maxError, error < 0 ? -error : error);
+			}
+		}
+		m_maxError[e] = maxError;
+	}
+}
+
+inline const float* SampledEasing::SamplesOf(EasingFunction easing) const
+{
+	const size_t e = static_cast<unsigned int>(easing);
+	return e < m_maxError.size() ? &m_samples[e * m_resolution] : nullptr;
+}
+
+inline float SampledEasing::Evaluate(EasingFunction easing, float t) const
+{
+	const float* samples = SamplesOf(easing);
+	if (!samples)
+	{
+		return Detail::Ease(easing, t);
+	}
+
+	const float x = std::min(std::max(t, 0.0f), 1.0f) * m_scale;
+	const size_t i = std::min(static_cast<size_t>(x), m_resolution - 2);
+	const float fraction = x - static_cast<float>(i);
+
+	return samples[i] + (samples[i + 1] - samples[i]) * fraction;
+}
+
+inline void SampledEasing::EvaluateRange(EasingFunction easing, float* t, size_t count) const
+{
+	const float* samples = SamplesOf(easing);
+	if (!samples)
+	{
+		Detail::EaseBatch(easing, t, count);
+		return;
+	}
+
+	const size_t last = m_resolution - 2;
+	for (size_t k = 0; k < count; ++k)
+	{
+		const float x = std::min(std::max(t[k], 0.0f), 1.0f) * m_scale;
+		const size_t i = std::min(static_cast<size_t>(x), last);
+		const float fraction = x - static_cast<float>(i);
+		t[k] = samples[i] + (samples[i + 1] - samples[i]) * fraction;
+	}
+}
+
+inline size_t SampledEasing::GetResolution() const
+{
+	return m_resolution;
+}
+
+inline float SampledEasing::MaxError(EasingFunction easing) const
+{
+	const size_t e = static_cast<unsigned int>(easing);
+	return e < m_maxError.size() ? m_maxError[e] : 0.0f;
+}
+
+inline float SampledEasing::MaxError() const
+{
+	return *std::max_element(m_maxError.begin(), m_maxError.end());
+}
+
+// Non-owning view over contiguous elements, stands in for std::span before C++20
+// Built from any container with data() and size(), C arrays or a pointer and a size
+// *Lower case members so it works with range-for and std algorithms
+template<class T>
+class TweenSpan
+{
+public:
+	TweenSpan()
+		:m_data(nullptr),
+		m_size(0)
+	{}
+
+	TweenSpan(T* data, size_t size)
+		:m_data(data),
+		m_size(size)
+	{}
+
+	template<size_t N> TweenSpan(T (&array)[N])
+		:m_data(array),
+		m_size(N)
+	{}
+
+	template<class Container, class = typename std::enable_if<std::is_convertible<decltype(std::declval<Container&>().data()), T*>::value>::type>
+	TweenSpan(Container&& container)
+		:m_data(container.data()),
+		m_size(container.size())
+	{}
+
+	T* data() const { return m_data; }
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	T* begin() const { return m_data; }
+	T* end() const { return m_data + m_size; }
+	T& operator[](size_t index) const { return m_data[index]; }
+
+private:
+	T* m_data;
+	size_t m_size;
+};
+
+#ifdef STWEEN_STATS
+// What the last STween::Update() did, see STween::GetStats()
+struct TweenStats
+{
+	// Tweens in the arrays when Update() started
+	size_t active;
+	// Tweens still waiting on Delay() after Update()
+	size_t parked;
+	// Values computed, 0 in pull mode
+	size_t evaluated;
+	size_t stepCallbacks;
+	size_t finished;
+	// Chain() sequences started
+	size_t chained;
+	// Waking delayed tweens
+	double wakeSeconds;
+	// Easing, evaluation and target writes, callbacks excluded
+	double evaluateSeconds;
+	// Step and finish callbacks and starting chains
+	double callbackSeconds;
+	// Moving chained tweens down and shrinking the arrays
+	double compactSeconds;
+	double totalSeconds;
+};
+
+namespace Detail
+{
+inline double StatsNow()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+#endif
+
+// Time scale and pause state shared by many tweens, of any type and manager
+// Pausing or slowing a group is a single write whatever the amount of tweens in it
+// TweenGroup gameplay;
+// TweenGroup enemies(&gameplay);
+// tweens.From(&x).To(1.0f).Time(1.0f).Group(&enemies);
+// gameplay.SetTimeScale(0.25f); // slows down enemies too
+// *Must outlive the tweens assigned to it
+class TweenGroup
+{
+public:
+	explicit TweenGroup(const TweenGroup* parent = nullptr)
+		:m_parent(parent),
+		m_timeScale(1.0f),
+		m_paused(false)
+	{}
+
+	void SetTimeScale(float scale) { m_timeScale = scale; }
+	float GetTimeScale() const { return m_timeScale; }
+	void Pause() { m_paused = true; }
+	void Resume() { m_paused = false; }
+	bool IsPaused() const { return m_paused; }
+
+	// Scale applied to deltaTime with the parents taken into account, 0 while any of them is paused
+	float GetEffectiveScale() const
+	{
+		float scale = 1.0f;
+		for (const TweenGroup* group = this; group; group = group->m_parent)
+		{
+			if (group->m_paused)
+				return 0.0f;
+			scale *= group->m_timeScale;
+		}
+		return scale;
+	}
+
+private:
+	const TweenGroup* m_parent;
+	float m_timeScale;
+	bool m_paused;
+};
+
 // Stores tweening data
 // *Mostly used internally
 // Can be created individually to later be added into STween if needed
@@ -66,9 +707,13 @@ struct TweenData
 public:
 	TweenData(int tID)
 		:tweenID(tID),
-		initialValue(nullptr),
 		reversed(false),
-		easing(Linear)
+		initialValue(nullptr),
+		easing(Linear),
+		delay(0),
+		group(nullptr),
+		loops(0),
+		yoyo(false)
 	{}
 
 	inline bool operator==(const TweenData& td)
@@ -90,446 +735,6423 @@ public:
 	std::function<void()> finishCallback;
 	std::function<void(T&)> stepCallback;
 	std::vector<TweenData<T>> endTween;
+	// Seconds left before the tween starts
+	float delay;
+	const TweenGroup* group;
+	// Times the tween starts over once its current play ends, ~0u loops until killed
+	unsigned int loops;
+	// Every other play goes backwards
+	bool yoyo;
 };
 
-// Main class
-// Creates and processes TweenData
-// Can be used as many times for a specific type 'T'
-// *Must-to-call functions to create a tween: From, To, Time
+// Read-only view of the arrays of an STween, see STween::View()
+// Every span has 'size' elements, index i of each one is the same tween
 template <class T>
-class STween
+struct TweenView
+{
+	size_t size;
+	// Normalized position, 1 once finished
+	TweenSpan<const float> progress;
+	TweenSpan<const float> duration;
+	TweenSpan<const T> start;
+	TweenSpan<const T> end;
+	TweenSpan<const EasingFunction> easing;
+	// nullptr for tweens created with From(T)
+	TweenSpan<T* const> target;
+};
+
+// Stable reference to a tween inside an STween
+// Stays valid while the tween moves around in storage
+// and expires once the tween finishes or is killed
+struct TweenHandle
+{
+	TweenHandle()
+		:index(0),
+		generation(0)
+	{}
+
+	TweenHandle(unsigned int slotIndex, unsigned int slotGeneration)
+		:index(slotIndex),
+		generation(slotGeneration)
+	{}
+
+	inline bool operator==(const TweenHandle& th) const
+	{
+		return this->index == th.index && this->generation == th.generation;
+	}
+
+	inline bool operator!=(const TweenHandle& th) const
+	{
+		return !(*this == th);
+	}
+
+	// Default constructed handles never refer to a tween
+	inline bool IsValid() const
+	{
+		return generation != 0;
+	}
+
+	unsigned int index;
+	unsigned int generation;
+};
+
+struct TweenWaiter;
+
+// Links one awaited tween to its waiter, kept by STween in a list per handle slot
+// *Used internally, see TweenAwaiter
+struct TweenWaitNode
+{
+	TweenWaitNode* next;
+	TweenWaiter* waiter;
+};
+
+// Waits for tweens to finish or be killed
+// Queued once 'pending' reaches 0 and resumed at the end of that STween::Update()
+// *Used internally, see TweenAwaiter
+struct TweenWaiter
+{
+	unsigned int pending;
+	TweenWaiter* nextReady;
+	void (*resume)(TweenWaiter* waiter);
+};
+
+// Tween awaited by a TweenWaiter and the manager running it
+// *Used internally, see TweenAwaiter
+struct TweenAwaitEntry
+{
+	void* manager;
+	TweenHandle handle;
+	// Links 'node' to the tween of 'handle', false if it already expired
+	bool (*link)(void* manager, TweenHandle handle, TweenWaitNode& node);
+};
+
+#ifdef STWEEN_COROUTINES
+// Awaitable returned by STween::Play(), STween::AllOf() and AllOf()
+// co_await tweens.Play(tweens.From(&x).To(1.0f).Time(0.5f).GetHandle());
+// co_await AllOf(tweens.Play(a), others.Play(b));
+// The coroutine resumes at the end of the Update() in which the last of its tweens finished or was killed,
+// in one pass with every other coroutine that Update() is done with
+// Waiting links one TweenWaitNode per tween, stored inside the awaiter in the coroutine frame, nothing is allocated
+// *Doesn't suspend if every tween had already expired
+// *The coroutine must not be destroyed while suspended here, nor its STween while it waits
+template<size_t N>
+class TweenAwaiter : private TweenWaiter
 {
 public:
-	STween();
-	~STween();
-	
-	// Creates a Tween starting from the initial value given
-	// Also sets the value each frame to the variable it points to
-	// *Only use when the object pointing to is guaranteed to be alive
-	// *Must-to-call
-	STween& From(T* initVal);
-	// Creates a Tween starting from the initial value given
-	// A setter callback for the value needs to be set with OnStep()
-	// *Must-to-call
-	STween& From(T initVal);
-	// Sets the desired final value
-	// *Must-to-call
-	STween& To(T finalVal);
+	template<class... Entries> explicit TweenAwaiter(const Entries&... entries)
+		:m_entries{ entries... }
+	{}
+
+	bool await_ready() const noexcept { return false; }
+
+	bool await_suspend(std::coroutine_handle<> coroutine)
+	{
+		m_coroutine = coroutine;
+		pending = 0;
+		nextReady = nullptr;
+		resume = &TweenAwaiter::Resume;
+		for (size_t k = 0; k < N; ++k)
+		{
+			m_nodes[k].waiter = this;
+			pending += m_entries[k].link(m_entries[k].manager, m_entries[k].handle, m_nodes[k]) ? 1 : 0;
+		}
+		return pending != 0;
+	}
+
+	void await_resume() const noexcept {}
+
+	// Tween awaited by TweenAwaiter<1>, used by AllOf()
+	const TweenAwaitEntry& Entry() const
+	{
+		static_assert(N == 1, "AllOf() combines the awaiters of single tweens");
+		return m_entries[0];
+	}
+
+private:
+	static void Resume(TweenWaiter* waiter)
+	{
+		static_cast<TweenAwaiter*>(waiter)->m_coroutine.resume();
+	}
+
+	TweenAwaitEntry m_entries[N];
+	TweenWaitNode m_nodes[N];
+	std::coroutine_handle<> m_coroutine;
+};
+
+// Awaits tweens of any managers at once
+// co_await AllOf(positions.Play(a), colors.Play(b));
+template<class... Awaiters> TweenAwaiter<sizeof...(Awaiters)> AllOf(const Awaiters&... awaiters)
+{
+	return TweenAwaiter<sizeof...(Awaiters)>(awaiters.Entry()...);
+}
+#endif
+
+// Receives what STween::Update() did in bulk when callbacks are deferred,
+// see STween::SetDeferredCallbacks()
+// Spans stay valid until the next Update()
+template <class T>
+class TweenBatchHandler
+{
+public:
+	virtual ~TweenBatchHandler() {}
+
+	// Every tween evaluated this frame and the value written to its target,
+	// the final value for the ones that finished
+	virtual void OnStep(TweenSpan<const TweenHandle> handles, TweenSpan<const T> values) { (void)handles; (void)values; }
+	// Tweens that finished this frame, their handles have already expired
+	virtual void OnFinish(TweenSpan<const TweenHandle> handles) { (void)handles; }
+};
+
+// std::vector using the allocator given to STween
+template <class U, class Alloc>
+using TweenVector = std::vector<U, typename std::allocator_traits<Alloc>::template rebind_alloc<U>>;
+
+// How values of T are computed
+// By default through the operators of T: (end - start) * eased + start
+// Types made of N contiguous floats (vectors, colors, matrices) can declare them,
+// they are then resolved and evaluated as N float lanes without calling any operator of T:
+// template<> struct STween::TweenTraits<Vec3> { static const size_t Components = 3; };
+// *Requires a trivially copyable T of exactly N floats
+template <class T>
+struct TweenTraits
+{
+	static const size_t Components = 0;
+};
+
+namespace Detail
+{
+// Empty std::function and null function pointers make an empty TweenFunction
+template<class F> inline bool IsNullCallable(const F&) { return false; }
+template<class S> inline bool IsNullCallable(const std::function<S>& f) { return !f; }
+template<class R, class... Args> inline bool IsNullCallable(R (*f)(Args...)) { return f == nullptr; }
+
+// Type of (end - start)
+// Kept apart from T so unsigned and small integer types can tween downwards
+// Float lane types keep their delta in a T
+template<class T, bool Flat = (TweenTraits<T>::Components > 0)> struct DeltaOf
+{
+	typedef typename std::decay<decltype(std::declval<const T&>() - std::declval<const T&>())>::type type;
+};
+
+template<class T> struct DeltaOf<T, true>
+{
+	typedef T type;
+};
+
+// Length of a delta, 0 for types without one so callers fall back to something else
+template<class D> inline float LengthOf(const D& delta, std::true_type) { return std::fabs(static_cast<float>(delta)); }
+template<class D> inline float LengthOf(const D&, std::false_type) { return 0.0f; }
+
+// Base and delta of a tween and its value for an eased factor, see TweenTraits
+template<class T, bool Flat = (TweenTraits<T>::Components > 0)> struct Lanes
+{
+	typedef typename DeltaOf<T>::type Delta;
+
+	static inline void Resolve(const T& from, const T& to, T& base, Delta& delta)
+	{
+		base = from;
+		delta = to - from;
+	}
+
+	static inline T Evaluate(const T& base, const Delta& delta, float eased)
+	{
+		return static_cast<T>(delta * eased + base);
+	}
+
+	static inline float Length(const Delta& delta)
+	{
+		return LengthOf(delta, std::is_arithmetic<Delta>());
+	}
+};
+
+// lanes[c] = delta[c] * eased + base[c], unrolled at compile time since -O2 keeps short loops
+template<size_t C, size_t N> struct LaneMultiplyAdd
+{
+	static inline void Apply(float* lanes, const float* base, const float* delta, float eased)
+	{
+		lanes[C] = delta[C] * eased + base[C];
+		LaneMultiplyAdd<C + 1, N>::Apply(lanes, base, delta, eased);
+	}
+};
+
+template<size_t N> struct LaneMultiplyAdd<N, N>
+{
+	static inline void Apply(float*, const float*, const float*, float) {}
+};
+
+template<class T> struct Lanes<T, true>
+{
+	typedef T Delta;
+	static const size_t N = TweenTraits<T>::Components;
+	static_assert(sizeof(T) == N * sizeof(float) && std::is_trivially_copyable<T>::value, "TweenTraits<T>::Components must be the amount of floats T is made of");
+
+	static inline void Resolve(const T& from, const T& to, T& base, T& delta)
+	{
+		const float* begin = reinterpret_cast<const float*>(&from);
+		const float* end = reinterpret_cast<const float*>(&to);
+		float* lanes = reinterpret_cast<float*>(&delta);
+		for (size_t c = 0; c < N; ++c)
+		{
+			lanes[c] = end[c] - begin[c];
+		}
+		base = from;
+	}
+
+	static inline T Evaluate(const T& base, const T& delta, float eased)
+	{
+		T value;
+		LaneMultiplyAdd<0, N>::Apply(reinterpret_cast<float*>(&value), reinterpret_cast<const float*>(&base), reinterpret_cast<const float*>(&delta), eased);
+		return value;
+	}
+
+	static inline float Length(const T& delta)
+	{
+		const float* lanes = reinterpret_cast<const float*>(&delta);
+		float sum = 0.0f;
+		for (size_t c = 0; c < N; ++c)
+		{
+			sum += lanes[c] * lanes[c];
+		}
+		return std::sqrt(sum);
+	}
+};
+
+// Operations applied to every per-tween array through ForEachColumn()
+struct ColumnPush
+{
+	template<class Column> void operator()(Column& column) const { column.emplace_back(); }
+};
+
+struct ColumnMove
+{
+	size_t from;
+	size_t to;
+	template<class Column> void operator()(Column& column) const { column[to] = std::move(column[from]); }
+};
+
+struct ColumnSwap
+{
+	size_t a;
+	size_t b;
+	template<class Column> void operator()(Column& column) const { std::swap(column[a], column[b]); }
+};
+
+struct ColumnResize
+{
+	size_t size;
+	template<class Column> void operator()(Column& column) const { column.resize(size); }
+};
+
+struct ColumnReserve
+{
+	size_t capacity;
+	template<class Column> void operator()(Column& column) const { column.reserve(capacity); }
+};
+
+struct ColumnTruncate
+{
+	size_t count;
+	template<class Column> void operator()(Column& column) const { column.erase(column.begin() + count, column.end()); }
+};
+
+// Counts the arrays that will reallocate on their next push
+struct ColumnGrowth
+{
+	size_t count;
+	template<class Column> void operator()(Column& column) { count += column.size() == column.capacity(); }
+};
+
+// Moves one element of the second array to the end of the first one
+struct ColumnPushFrom
+{
+	size_t index;
+	template<class Column> void operator()(Column& column, Column& source) const { column.push_back(std::move(source[index])); }
+};
+
+// Moves every element of the second array to the end of the first one
+struct ColumnAppend
+{
+	template<class Column> void operator()(Column& column, Column& source) const
+	{
+		column.insert(column.end(), std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()));
+	}
+};
+
+// Copies the second array over the first one
+struct ColumnAssign
+{
+	template<class Column> void operator()(Column& column, const Column& source) const { column = source; }
+};
+
+// Adapts a single array operation to ForEachColumnPair()
+template<class Visitor> struct FirstColumn
+{
+	Visitor& visitor;
+	template<class Column> void operator()(Column& column, Column&) const { visitor(column); }
+};
+
+// Moves 'value' out of rvalue sources, copies it from lvalue ones
+template<class Source, class U> inline typename std::conditional<std::is_lvalue_reference<Source>::value, const U&, U&&>::type ForwardFrom(U& value)
+{
+	return static_cast<typename std::conditional<std::is_lvalue_reference<Source>::value, const U&, U&&>::type>(value);
+}
+}
+
+template<class Signature>
+class TweenFunction;
+
+// Small-buffer callback
+// Callables up to STWEEN_CALLBACK_CAPACITY bytes are stored inline and never allocate, std::function always fits
+// Bigger ones are allocated through the allocator given, std::allocator by default,
+// STween and the tween groups pass their own 'Alloc'
+// *With STWEEN_NO_CALLBACK_HEAP callables that don't fit fail to compile, so callbacks are guaranteed not to allocate
+template<class R, class... Args>
+class TweenFunction<R(Args...)>
+{
+public:
+	static const size_t Capacity = STWEEN_CALLBACK_CAPACITY;
+
+	TweenFunction()
+		:m_ops(nullptr)
+	{}
+
+	TweenFunction(std::nullptr_t)
+		:m_ops(nullptr)
+	{}
+
+	template<class F, class = typename std::enable_if<!std::is_same<typename std::decay<F>::type, TweenFunction>::value>::type>
+	TweenFunction(F&& callable)
+		:m_ops(nullptr)
+	{
+		Store(std::allocator<char>(), std::forward<F>(callable));
+	}
+
+	// Same as above, callables that don't fit inline are allocated through 'alloc'
+	template<class A, class F>
+	TweenFunction(std::allocator_arg_t, const A& alloc, F&& callable)
+		:m_ops(nullptr)
+	{
+		Store(alloc, std::forward<F>(callable));
+	}
+
+	TweenFunction(const TweenFunction& other)
+		:m_ops(nullptr)
+	{
+		CopyFrom(other);
+	}
+
+	// Leaves 'other' empty
+	TweenFunction(TweenFunction&& other)
+		:m_ops(nullptr)
+	{
+		MoveFrom(other);
+	}
+
+	~TweenFunction()
+	{
+		Reset();
+	}
+
+	TweenFunction& operator=(const TweenFunction& other)
+	{
+		if (this != &other)
+		{
+			Reset();
+			CopyFrom(other);
+		}
+		return *this;
+	}
+
+	TweenFunction& operator=(TweenFunction&& other)
+	{
+		if (this != &other)
+		{
+			Reset();
+			MoveFrom(other);
+		}
+		return *this;
+	}
+
+	explicit operator bool() const
+	{
+		return m_ops != nullptr;
+	}
+
+	R operator()(Args... args) const
+	{
+		return m_ops->invoke(const_cast<unsigned char*>(m_storage), std::forward<Args>(args)...);
+	}
+
+	void Reset()
+	{
+		if (m_ops)
+		{
+			if (!m_ops->trivial)
+				m_ops->destroy(m_storage);
+			m_ops = nullptr;
+		}
+	}
+
+private:
+	struct Ops
+	{
+		R (*invoke)(void* storage, Args&&... args);
+		void (*copy)(void* storage, const void* other);
+		void (*move)(void* storage, void* other);
+		void (*destroy)(void* storage);
+		// Copied with memcpy and never destroyed, e.g. lambdas capturing pointers
+		bool trivial;
+	};
+
+	// Expect this to be empty
+	void CopyFrom(const TweenFunction& other)
+	{
+		m_ops = other.m_ops;
+		if (!m_ops)
+			return;
+		if (m_ops->trivial)
+			std::memcpy(m_storage, other.m_storage, Capacity);
+		else
+			m_ops->copy(m_storage, other.m_storage);
+	}
+
+	void MoveFrom(TweenFunction& other)
+	{
+		m_ops = other.m_ops;
+		if (!m_ops)
+			return;
+		if (m_ops->trivial)
+		{
+			std::memcpy(m_storage, other.m_storage, Capacity);
+			other.m_ops = nullptr;
+		}
+		else
+		{
+			m_ops->move(m_storage, other.m_storage);
+			other.Reset();
+		}
+	}
+
+	template<class Callable>
+	struct OpsFor
+	{
+		static R Invoke(void* storage, Args&&... args) { return (*static_cast<Callable*>(storage))(std::forward<Args>(args)...); }
+		static void Copy(void* storage, const void* other) { new (storage) Callable(*static_cast<const Callable*>(other)); }
+		static void Move(void* storage, void* other) { new (storage) Callable(std::move(*static_cast<Callable*>(other))); }
+		static void Destroy(void* storage) { static_cast<Callable*>(storage)->~Callable(); }
+		static const Ops ops;
+	};
+
+	// Callable that doesn't fit inline, the allocator and a pointer to it are stored instead
+	template<class Callable, class A>
+	struct Boxed
+	{
+		typedef typename std::allocator_traits<A>::template rebind_alloc<Callable> Allocator;
+		typedef std::allocator_traits<Allocator> Traits;
+
+		template<class F>
+		Boxed(const A& alloc, F&& value)
+			:allocator(alloc),
+			callable(Traits::allocate(allocator, 1))
+		{
+			try
+			{
+				Traits::construct(allocator, callable, std::forward<F>(value));
+			}
+			catch (...)
+			{
+				Traits::deallocate(allocator, callable, 1);
+				throw;
+			}
+		}
+
+		Allocator allocator;
+		Callable* callable;
+	};
+
+	template<class Callable, class A>
+	struct BoxedOpsFor
+	{
+		typedef Boxed<Callable, A> Box;
+		static R Invoke(void* storage, Args&&... args) { return (*static_cast<Box*>(storage)->callable)(std::forward<Args>(args)...); }
+		static void Copy(void* storage, const void* other)
+		{
+			const Box& box = *static_cast<const Box*>(other);
+			Box* copy = new (storage) Box(box);
+			copy->callable = Box::Traits::allocate(copy->allocator, 1);
+			try
+			{
+				Box::Traits::construct(copy->allocator, copy->callable, *box.callable);
+			}
+			catch (...)
+			{
+				Box::Traits::deallocate(copy->allocator, copy->callable, 1);
+				copy->~Box();
+				throw;
+			}
+		}
+		// The pointer changes hands, the callable itself stays where it is
+		static void Move(void* storage, void* other)
+		{
+			Box& box = *static_cast<Box*>(other);
+			new (storage) Box(box);
+			box.callable = nullptr;
+		}
+		static void Destroy(void* storage)
+		{
+			Box& box = *static_cast<Box*>(storage);
+			if (box.callable)
+			{
+				Box::Traits::destroy(box.allocator, box.callable);
+				Box::Traits::deallocate(box.allocator, box.callable, 1);
+			}
+			box.~Box();
+		}
+		static const Ops ops;
+	};
+
+	template<class A, class F>
+	void Store(const A& alloc, F&& callable)
+	{
+		typedef typename std::decay<F>::type Callable;
+		if (Detail::IsNullCallable(callable))
+		{
+			return;
+		}
+
+		Store<Callable>(std::integral_constant<bool, sizeof(Callable) <= Capacity && alignof(Callable) <= alignof(std::max_align_t)>(), alloc, std::forward<F>(callable));
+	}
+
+	template<class Callable, class A, class F>
+	void Store(std::true_type, const A&, F&& callable)
+	{
+		new (m_storage) Callable(std::forward<F>(callable));
+		m_ops = &OpsFor<Callable>::ops;
+	}
+
+	template<class Callable, class A, class F>
+	void Store(std::false_type, const A& alloc, F&& callable)
+	{
+#ifdef STWEEN_NO_CALLBACK_HEAP
+		static_assert(sizeof(Callable) == 0, "Callback too big for TweenFunction, raise STWEEN_CALLBACK_CAPACITY");
+#endif
+		static_assert(sizeof(Boxed<Callable, A>) <= Capacity, "Allocator too big to be stored by TweenFunction");
+		new (m_storage) Boxed<Callable, A>(alloc, std::forward<F>(callable));
+		m_ops = &BoxedOpsFor<Callable, A>::ops;
+	}
+
+	alignas(std::max_align_t) unsigned char m_storage[Capacity];
+	const Ops* m_ops;
+};
+
+template<class R, class... Args> template<class Callable>
+const typename TweenFunction<R(Args...)>::Ops TweenFunction<R(Args...)>::OpsFor<Callable>::ops =
+{
+	&TweenFunction<R(Args...)>::OpsFor<Callable>::Invoke,
+	&TweenFunction<R(Args...)>::OpsFor<Callable>::Copy,
+	&TweenFunction<R(Args...)>::OpsFor<Callable>::Move,
+	&TweenFunction<R(Args...)>::OpsFor<Callable>::Destroy,
+	std::is_trivially_copyable<Callable>::value && std::is_trivially_destructible<Callable>::value
+};
+
+template<class R, class... Args> template<class Callable, class A>
+const typename TweenFunction<R(Args...)>::Ops TweenFunction<R(Args...)>::BoxedOpsFor<Callable, A>::ops =
+{
+	&TweenFunction<R(Args...)>::BoxedOpsFor<Callable, A>::Invoke,
+	&TweenFunction<R(Args...)>::BoxedOpsFor<Callable, A>::Copy,
+	&TweenFunction<R(Args...)>::BoxedOpsFor<Callable, A>::Move,
+	&TweenFunction<R(Args...)>::BoxedOpsFor<Callable, A>::Destroy,
+	false
+};
+
+// Fixed-size memory block handing out memory linearly
+// Nothing is freed on its own, Reset() releases everything at once
+// Used through TweenArenaAllocator:
+// TweenArena arena(buffer, sizeof(buffer));
+// STween<float, TweenArenaAllocator<float>> tweens(arena);
+// *Containers leave their old storage behind when they grow, Reserve() storage up front
+class TweenArena
+{
+public:
+	TweenArena(void* buffer, size_t size);
+
+	// Returns 'size' bytes aligned to 'alignment'
+	// Throwing std::bad_alloc once the block is exhausted
+	void* Allocate(size_t size, size_t alignment);
+	// Releases every allocation at once
+	// *Only call once nothing allocated from it is used anymore
+	void Reset();
+	// Bytes handed out so far, including alignment padding
+	size_t GetUsed() const;
+	size_t GetCapacity() const;
+
+private:
+	unsigned char* m_buffer;
+	size_t m_size;
+	size_t m_used;
+};
+
+inline TweenArena::TweenArena(void* buffer, size_t size)
+	:m_buffer(static_cast<unsigned char*>(buffer)),
+	m_size(size),
+	m_used(0)
+{}
+
+inline void* TweenArena::Allocate(size_t size, size_t alignment)
+{
+	const size_t address = reinterpret_cast<size_t>(m_buffer) + m_used;
+	const size_t padding = (alignment - address % alignment) % alignment;
+	if (padding + size > m_size - m_used)
+	{
+		throw std::bad_alloc();
+	}
+
+	m_used += padding;
+	void* memory = m_buffer + m_used;
+	m_used += size;
+
+	return memory;
+}
+
+inline void TweenArena::Reset()
+{
+	m_used = 0;
+}
+
+inline size_t TweenArena::GetUsed() const
+{
+	return m_used;
+}
+
+inline size_t TweenArena::GetCapacity() const
+{
+	return m_size;
+}
+
+// Standard allocator drawing memory from a TweenArena
+template <class T>
+class TweenArenaAllocator
+{
+public:
+	typedef T value_type;
+
+	TweenArenaAllocator(TweenArena& arena)
+		:m_arena(&arena)
+	{}
+
+	template <class U>
+	TweenArenaAllocator(const TweenArenaAllocator<U>& other)
+		:m_arena(other.GetArena())
+	{}
+
+	T* allocate(size_t count)
+	{
+		return static_cast<T*>(m_arena->Allocate(count * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T*, size_t)
+	{}
+
+	TweenArena* GetArena() const
+	{
+		return m_arena;
+	}
+
+private:
+	TweenArena* m_arena;
+};
+
+template <class T, class U>
+inline bool operator==(const TweenArenaAllocator<T>& a, const TweenArenaAllocator<U>& b)
+{
+	return a.GetArena() == b.GetArena();
+}
+
+template <class T, class U>
+inline bool operator!=(const TweenArenaAllocator<T>& a, const TweenArenaAllocator<U>& b)
+{
+	return a.GetArena() != b.GetArena();
+}
+
+// Interface to plug a job system into STween::Update()
+class TweenJobSystem
+{
+public:
+	virtual ~TweenJobSystem() {}
+
+	// Calls job(context, begin, end) over ranges of at most 'grain' items covering [0, count)
+	// Ranges may run concurrently, must return once all of them are done
+	virtual void ParallelFor(size_t count, size_t grain, void (*job)(void* context, size_t begin, size_t end), void* context) = 0;
+};
+
+// Lock-free queue through which any thread starts tweens, drained by STween::Update()
+// STween::TweenSubmitQueue<float> queue(4096);
+// tweens.SetSubmitQueue(&queue);
+// queue.Submit(&volume, 1.0f, 0.0f, 0.5f); // from a job thread
+// Bounded ring of cells allocated once through 'Alloc', submitting never blocks nor allocates
+// Update() takes the tweens queued when it starts and adds them in submission order
+// *Submit() returns false while the ring is full, size it for the tweens started between two updates
+// *Callbacks of submitted tweens run on the thread calling Update()
+template <class T, class Alloc = std::allocator<T>>
+class TweenSubmitQueue
+{
+public:
+	// Room for 'capacity' queued tweens, rounded up to a power of two
+	explicit TweenSubmitQueue(size_t capacity = 1024, const Alloc& alloc = Alloc());
+	~TweenSubmitQueue();
+
+	// Queues a fully built tween, see TweenData
+	// Returns false, leaving 'tween' as it was, if the queue is full
+	// Thread-safe
+	bool Submit(TweenData<T>&& tween);
+	bool Submit(const TweenData<T>& tween);
+	// Queues a tween from 'from' to 'to' writing to 'target', nullptr for none
+	// The start value is given since reading 'target' here would race with Update()
+	// Returns false if the queue is full
+	// Thread-safe
+	bool Submit(T* target, const T& from, const T& to, float duration, EasingFunction easing = Linear);
+	// Takes the tweens queued so far and calls consumer(TweenData<T>&&) on each, oldest first
+	// A tween still being written by its thread is left for the next call along with the ones after it
+	// *Only one thread may drain at a time
+	template<class Consumer> void Drain(Consumer consumer);
+	// Returns true if nothing is queued, may be outdated by the time it returns
+	bool Empty() const;
+	size_t Capacity() const;
+
+private:
+	TweenSubmitQueue(const TweenSubmitQueue&);
+	TweenSubmitQueue& operator=(const TweenSubmitQueue&);
+
+	// 'sequence' tells whose turn the cell is:
+	// its position for the next producer, position + 1 once written for the consumer
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		alignas(TweenData<T>) unsigned char storage[sizeof(TweenData<T>)];
+	};
+
+	typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Cell> CellAllocator;
+	typedef std::allocator_traits<CellAllocator> CellTraits;
+
+	// Shared by both TweenData overloads
+	template<class Data> bool Push(Data&& tween);
+
+	CellAllocator m_allocator;
+	Cell* m_cells;
+	size_t m_mask;
+	// Positions claimed by producers and taken by the consumer, kept on separate cache lines
+	std::atomic<size_t> m_tail;
+	unsigned char m_padding[64];
+	std::atomic<size_t> m_head;
+};
+
+template<class T, class Alloc>TweenSubmitQueue<T, Alloc>::TweenSubmitQueue(size_t capacity, const Alloc& alloc)
+	:m_allocator(alloc),
+	m_cells(nullptr),
+	m_mask(0),
+	m_tail(0),
+	m_head(0)
+{
+	size_t size = 1;
+	while (size < capacity)
+	{
+		size <<= 1;
+	}
+
+	m_cells = CellTraits::allocate(m_allocator, size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		new (&m_cells[i].sequence) std::atomic<size_t>(i);
+	}
+	m_mask = size - 1;
+}
+
+template<class T, class Alloc>TweenSubmitQueue<T, Alloc>::~TweenSubmitQueue()
+{
+	// Leftover tweens are destroyed with the queue
+	Drain([](TweenData<T>&&) {});
+	for (size_t i = 0; i <= m_mask; ++i)
+	{
+		m_cells[i].sequence.~atomic();
+	}
+	CellTraits::deallocate(m_allocator, m_cells, m_mask + 1);
+}
+
+template<class T, class Alloc> template<class Data> bool TweenSubmitQueue<T, Alloc>::Push(Data&& tween)
+{
+	size_t position = m_tail.load(std::memory_order_relaxed);
+	Cell* cell;
+	for (;;)
+	{
+		cell = &m_cells[position & m_mask];
+		const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		if (sequence == position)
+		{
+			// Free cell, claimed once the tail moves past it
+			if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (sequence < position)
+		{
+			// Still holds the tween queued one lap earlier
+			return false;
+		}
+		else
+		{
+			position = m_tail.load(std::memory_order_relaxed);
+		}
+	}
+
+	new (cell->storage) TweenData<T>(std::forward<Data>(tween));
+	cell->sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+template<class T, class Alloc>bool TweenSubmitQueue<T, Alloc>::Submit(TweenData<T>&& tween)
+{
+	return Push(std::move(tween));
+}
+
+template<class T, class Alloc>bool TweenSubmitQueue<T, Alloc>::Submit(const TweenData<T>& tween)
+{
+	return Push(tween);
+}
+
+template<class T, class Alloc>bool TweenSubmitQueue<T, Alloc>::Submit(T* target, const T& from, const T& to, float duration, EasingFunction easing)
+{
+	TweenData<T> tween(0);
+	tween.fromReady = true;
+	tween.byPointer = target != nullptr;
+	tween.initialValue = target;
+	tween.initialCpy = from;
+	tween.finalValue = to;
+	tween.duration = duration;
+	tween.easing = easing;
+	tween.timeCounter = 0;
+	return Push(std::move(tween));
+}
+
+template<class T, class Alloc> template<class Consumer> void TweenSubmitQueue<T, Alloc>::Drain(Consumer consumer)
+{
+	// Bounded by the tail seen now, so busy producers can't keep the consumer here
+	const size_t tail = m_tail.load(std::memory_order_acquire);
+	size_t head = m_head.load(std::memory_order_relaxed);
+	while (head != tail)
+	{
+		Cell& cell = m_cells[head & m_mask];
+		if (cell.sequence.load(std::memory_order_acquire) != head + 1)
+		{
+			break;
+		}
+
+		TweenData<T>& tween = *reinterpret_cast<TweenData<T>*>(cell.storage);
+		consumer(std::move(tween));
+		tween.~TweenData();
+		// Free again for the producer one lap later
+		cell.sequence.store(head + m_mask + 1, std::memory_order_release);
+		++head;
+		m_head.store(head, std::memory_order_relaxed);
+	}
+}
+
+template<class T, class Alloc>bool TweenSubmitQueue<T, Alloc>::Empty() const
+{
+	return m_tail.load(std::memory_order_relaxed) == m_head.load(std::memory_order_relaxed);
+}
+
+template<class T, class Alloc>size_t TweenSubmitQueue<T, Alloc>::Capacity() const
+{
+	return m_mask + 1;
+}
+
+#ifndef STWEEN_NO_THREADS
+// Built-in TweenJobSystem backed by std::thread
+// The thread calling ParallelFor() works on the ranges too
+// *Only one ParallelFor() may run at a time
+class TweenThreadPool : public TweenJobSystem
+{
+public:
+	// 'threadCount' includes the calling thread, 0 uses every hardware thread
+	explicit TweenThreadPool(unsigned int threadCount = 0);
+	virtual ~TweenThreadPool();
+
+	virtual void ParallelFor(size_t count, size_t grain, void (*job)(void* context, size_t begin, size_t end), void* context);
+
+private:
+	TweenThreadPool(const TweenThreadPool&);
+	TweenThreadPool& operator=(const TweenThreadPool&);
+
+	void WorkerLoop();
+	void RunRanges();
+
+	std::vector<std::thread> m_workers;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_done;
+	unsigned int m_generation;
+	unsigned int m_busyWorkers;
+	bool m_stop;
+	// Job being run
+	void (*m_job)(void* context, size_t begin, size_t end);
+	void* m_context;
+	size_t m_count;
+	size_t m_grain;
+	std::atomic<size_t> m_next;
+};
+
+inline TweenThreadPool::TweenThreadPool(unsigned int threadCount)
+	:m_generation(0),
+	m_busyWorkers(0),
+	m_stop(false),
+	m_job(nullptr),
+	m_context(nullptr),
+	m_count(0),
+	m_grain(1),
+	m_next(0)
+{
+	if (threadCount == 0)
+	{
+		threadCount = std::thread::hardware_concurrency();
+	}
+
+	for (unsigned int i = 1; i < threadCount; ++i)
+	{
+		m_workers.push_back(std::thread(&TweenThreadPool::WorkerLoop, this));
+	}
+}
+
+inline TweenThreadPool::~TweenThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+
+	for (auto &worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+inline void TweenThreadPool::ParallelFor(size_t count, size_t grain, void (*job)(void* context, size_t begin, size_t end), void* context)
+{
+	if (m_workers.empty() || count <= grain)
+	{
+		job(context, 0, count);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_job = job;
+		m_context = context;
+		m_count = count;
+		m_grain = grain;
+		m_next.store(0);
+		m_busyWorkers = static_cast<unsigned int>(m_workers.size());
+		++m_generation;
+	}
+	m_wake.notify_all();
+
+	RunRanges();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done.wait(lock, [this] { return m_busyWorkers == 0; });
+}
+
+inline void TweenThreadPool::WorkerLoop()
+{
+	unsigned int generation = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [this, generation] { return m_stop || m_generation != generation; });
+			if (m_stop)
+			{
+				return;
+			}
+			generation = m_generation;
+		}
+
+		RunRanges();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (--m_busyWorkers == 0)
+		{
+			m_done.notify_one();
+		}
+	}
+}
+
+inline void TweenThreadPool::RunRanges()
+{
+	for (;;)
+	{
+		const size_t begin = m_next.fetch_add(m_grain);
+		if (begin >= m_count)
+		{
+			return;
+		}
+
+		const size_t end = begin + m_grain < m_count ? begin + m_grain : m_count;
+		m_job(m_context, begin, end);
+	}
+}
+#endif
+
+template <class T, class Alloc = std::allocator<T>>
+struct TweenSequence;
+
+template <class T, class Alloc = std::allocator<T>>
+class TweenTimeline;
+
+template <class T, class Alloc = std::allocator<T>>
+class CompactTweenGroup;
+
+template <class Alloc = std::allocator<char>>
+class TweenWorld;
+
+// Per-tween data the per-frame loop rarely touches
+// Kept apart from the hot arrays so Update() only streams what it needs
+// *Used internally
+template <class T, class Alloc = std::allocator<T>>
+struct TweenCallbacks
+{
+	TweenFunction<void()> finishCallback;
+	TweenFunction<void(T&)> stepCallback;
+	// Tweens started once this one finishes
+	std::shared_ptr<const TweenSequence<T, Alloc>> endTween;
+};
+
+// Immutable group of tweens started together once a chained tween finishes
+// Shared by every tween chaining it, so chains of chains are never deep-copied
+// Starting it only copies the fields in the arrays, callbacks are borrowed
+// *Mostly used internally, created with STween::MakeSequence()
+template <class T, class Alloc>
+struct TweenSequence
+{
+	explicit TweenSequence(const Alloc& alloc = Alloc())
+		:timeCounter(alloc),
+		duration(alloc),
+		start(alloc),
+		end(alloc),
+		easing(alloc),
+		target(alloc),
+		flags(alloc),
+		delay(alloc),
+		group(alloc),
+		loops(alloc),
+		callbacks(alloc)
+	{}
+
+	TweenVector<float, Alloc> timeCounter;
+	TweenVector<float, Alloc> duration;
+	TweenVector<T, Alloc> start;
+	TweenVector<T, Alloc> end;
+	TweenVector<EasingFunction, Alloc> easing;
+	TweenVector<T*, Alloc> target;
+	TweenVector<unsigned char, Alloc> flags;
+	TweenVector<float, Alloc> delay;
+	TweenVector<const TweenGroup*, Alloc> group;
+	// Loops left, stored as by STween
+	TweenVector<unsigned int, Alloc> loops;
+	TweenVector<TweenCallbacks<T, Alloc>, Alloc> callbacks;
+};
+
+// Start of a snapshot made by STween::SaveSnapshot()
+// Followed by one block per field, each holding 'count' values:
+// start and end (T), progress, duration and delay (float), easing (int), id and loops (unsigned int), flags (1 byte)
+// *Values are stored in the byte order and layout of the machine that saved them
+struct TweenSnapshotHeader
+{
+	static const unsigned int Magic = 0x4E575453; // "STWN"
+	static const unsigned int Version = 2;
+
+	unsigned int magic;
+	unsigned int version;
+	unsigned int valueSize;
+	unsigned int count;
+};
+
+namespace Detail
+{
+// Byte offset of each block of a snapshot holding 'count' values of 'valueSize' bytes
+struct SnapshotLayout
+{
+	size_t start;
+	size_t end;
+	size_t progress;
+	size_t duration;
+	size_t delay;
+	size_t easing;
+	size_t id;
+	size_t loops;
+	size_t flags;
+	size_t size;
+};
+
+// Spreads pointers over a power of two table, low bits are mostly alignment
+inline size_t HashPointer(const void* pointer)
+{
+	const unsigned long long bits = reinterpret_cast<size_t>(pointer);
+	return static_cast<size_t>((bits >> 3) * 0x9E3779B97F4A7C15ull >> 16);
+}
+
+inline SnapshotLayout SnapshotLayoutOf(size_t count, size_t valueSize)
+{
+	SnapshotLayout layout;
+	layout.start = sizeof(TweenSnapshotHeader);
+	layout.end = layout.start + count * valueSize;
+	layout.progress = layout.end + count * valueSize;
+	layout.duration = layout.progress + count * sizeof(float);
+	layout.delay = layout.duration + count * sizeof(float);
+	layout.easing = layout.delay + count * sizeof(float);
+	layout.id = layout.easing + count * sizeof(int);
+	layout.loops = layout.id + count * sizeof(unsigned int);
+	layout.flags = layout.loops + count * sizeof(unsigned int);
+	layout.size = layout.flags + count;
+	return layout;
+}
+
+// Time of Update(), owned by a manager or shared by the managers of a TweenWorld
+struct TweenClock
+{
+	TweenClock()
+		:time(0),
+		tickRate(0),
+		tickSeconds(0),
+		ticks(0),
+		remainder(0)
+	{}
+
+	// Whole ticks deltaTime adds up to with the time left by the previous call, in tick mode
+	unsigned int AddTime(float deltaTime)
+	{
+		remainder += deltaTime;
+		const double whole = remainder * tickRate;
+		if (whole < 1.0)
+		{
+			return 0;
+		}
+
+		const unsigned int count = static_cast<unsigned int>(whole);
+		remainder -= count * tickSeconds;
+		return count;
+	}
+
+	// Moves time to the closest tick, tweens are anchored by their manager
+	void SetTickRate(unsigned int ticksPerSecond)
+	{
+		tickRate = ticksPerSecond;
+		tickSeconds = ticksPerSecond ? 1.0 / ticksPerSecond : 0;
+		remainder = 0;
+		if (ticksPerSecond)
+		{
+			ticks = static_cast<unsigned long long>(time * ticksPerSecond + 0.5);
+			time = ticks * tickSeconds;
+		}
+	}
+
+	// Once per Update(), 'count' is only used in tick mode
+	void Advance(float deltaTime, unsigned int count)
+	{
+		if (tickRate)
+		{
+			ticks += count;
+			time = ticks * tickSeconds;
+		}
+		else
+		{
+			time += deltaTime;
+		}
+	}
+
+	// Time gone through Update(), used for delays
+	double time;
+	// Tick mode, time is then ticks * tickSeconds
+	unsigned int tickRate;
+	double tickSeconds;
+	unsigned long long ticks;
+	// Time short of a whole tick, kept for the next Update()
+	double remainder;
+};
+}
+
+// Main class
+// Creates and processes TweenData
+// Can be used as many times for a specific type 'T'
+// *Must-to-call functions to create a tween: From, To, Time
+// Tweens are stored as a structure of arrays:
+// the fields read every frame live in separate contiguous arrays,
+// callbacks and chains are stored on the side
+// Every container and chained sequence uses 'Alloc', see TweenArena
+template <class T, class Alloc = std::allocator<T>>
+class STween
+{
+public:
+	explicit STween(const Alloc& alloc = Alloc());
+	// Copies every tween, delayed ones included, with their callbacks and settings
+	// Handles of the original name the same tweens in the copy
+	// *The copy runs on its own clock, doesn't take tweens from the submit queue and doesn't resume the awaiters of 'other'
+	STween(const STween& other);
+	// Same as the copy, the tweens replaced expire first
+	// *Managers of a TweenWorld stay on its clock
+	STween& operator=(const STween& other);
+	~STween();
+	
+	// Creates a Tween starting from the initial value given
+	// Also sets the value each frame to the variable it points to
+	// *Only use when the object pointing to is guaranteed to be alive
+	// *Must-to-call
+	STween& From(T* initVal);
+	// Creates a Tween starting from the initial value given
+	// A setter callback for the value needs to be set with OnStep()
+	// *Must-to-call
+	STween& From(T initVal);
+	// Sets the desired final value
+	// *Must-to-call
+	STween& To(T finalVal);
+	// Sets the duration of the tween
+	// *Must-to-call
+	STween& Time(float sec);
+	// Sets a callback once the tween is finished
+	// Any callable fitting in a TweenFunction is stored inline, bigger ones are allocated through 'Alloc'
+	// *Optional
+	template<class Callback> STween& OnFinish(Callback endCallback);
+	// Sets a callback for each frame the value is changing
+	// Use this method as a setter if From() argument is const
+	// Any callable fitting in a TweenFunction is stored inline, bigger ones are allocated through 'Alloc'
+	// *Optional
+	template<class Callback> STween& OnStep(Callback callabck);
+	// Chains another tween after this one ends
+	// The tweens of 'chain' are captured as they are now
+	// *Optional
+	STween& Chain(STween* chain);
+	// Chains a sequence after this one ends
+	// The sequence is shared, not copied, so it can be chained by many tweens
+	// *Optional
+	STween& Chain(std::shared_ptr<const TweenSequence<T, Alloc>> sequence);
+	// Reverses the current tween
+	// Values will be tweened from the final value to the initial value if set to true
+	// *Optional
+	STween& Reversed(bool isReversed);
+	// Plays the tween 'count' times in a row
+	// Progress wraps in place, so a looping tween costs the same as any running tween
+	// and only finishes, firing OnFinish() and Chain(), after its last play
+	// *Optional
+	STween& Loop(unsigned int count);
+	// Same as Loop() with every other play going backwards, Yoyo(2) goes there and back
+	// *Optional
+	STween& Yoyo(unsigned int count);
+	// Plays the tween until it is killed, back and forth if 'yoyo' is true
+	// *Optional
+	STween& LoopForever(bool yoyo = false);
+	// Sets the easing function, built-in or returned by RegisterEasing()
+	// Linear is set by default
+	// *Optional
+	STween& Easing(EasingFunction easingType);
+	// Waits 'sec' seconds before starting the tween
+	// The wait runs on the clock of its Group(), so it is paused and slowed down with it
+	// Waiting tweens are kept aside in a timer heap, so they cost nothing per frame
+	// Handles work on them as usual
+	// *Optional
+	STween& Delay(float sec);
+	// Runs the tween on the clock of 'group', nullptr runs it on this manager's clock
+	// *Optional
+	STween& Group(const TweenGroup* group);
+	// Sort key used by SetSortedTargets(), tweens of the same owner are kept next to each other
+	// e.g. the index of the component holding the target
+	// *Optional, 0 by default, not kept by GetTweens(), MakeSequence() nor snapshots
+	STween& Owner(unsigned int id);
+	// Returns all the tweens registered
+	// Helper function in case it is needed
+	// Normally used with AddTweens()
+	// a.AddTweens(b.GetTweens());
+	std::vector<TweenData<T>> GetTweens();
+	// Captures every tween registered as an immutable sequence
+	// Build once and chain it as many times as needed
+	// a.From(&x).To(1.0f).Time(1.0f).Chain(sequence);
+	std::shared_ptr<const TweenSequence<T, Alloc>> MakeSequence() const;
+	// Resets the STween object
+	void ReleaseTweens();
+	// Adds all the tweens from the container
+	// Helper function in case it is needed
+	// Normally used with GetTweens()
+	// a.AddTweens(b.GetTweens());
+	// Callbacks are moved out of a temporary container, copied otherwise
+	void AddTweens(std::vector<TweenData<T>>&& tweens);
+	void AddTweens(TweenSpan<const TweenData<T>> tweens);
+	// Appends a binary snapshot of every tween to 'out', see TweenSnapshotHeader
+	// Stores start, end, progress, duration, delay, easing, loops, direction and pause state
+	// targetId(TweenHandle, T* target) returns the unsigned int id LoadSnapshot() gets back for that tween
+	// *Callbacks, chains and groups are not stored, T must be trivially copyable
+	template<class TargetId> void SaveSnapshot(std::vector<unsigned char>& out, TargetId targetId) const;
+	// Replaces every tween with the ones of a snapshot, copying each field block at once
+	// bind(unsigned int id) is called with each restored tween as the current one and returns its target,
+	// nullptr for none; OnFinish(), OnStep() or Group() may be called on this manager from it
+	// tweens.LoadSnapshot(data, size, [&](unsigned int id) { tweens.OnFinish(finishes[id]); return &sprites[id].alpha; });
+	// Returns false without changing anything if the snapshot is malformed or was saved for another T
+	template<class Bind> bool LoadSnapshot(const void* data, size_t size, Bind bind);
+	// Creates one tween per target, from its current value to the final value at the same index
+	// Faster than the builder when spawning thousands of tweens at once
+	// tweens.AddBatch(targets, finals, 0.5f, QuadranticOut);
+	// *Extra elements of the longer span are ignored
+	// *A nullptr target makes a tween without target starting from its final value, see From(T)
+	void AddBatch(TweenSpan<T* const> targets, TweenSpan<const T> finals, float duration, EasingFunction easing = Linear);
+	// Allocates room for 'count' tweens in total
+	// Building and updating up to that many tweens won't allocate afterwards, callbacks aside
+	// *Scratch buffers are only reserved for the features enabled before the call
+	// *Callbacks, delays, loops and owners take pool entries, which are reused but grow the first time that many are used
+	void Reserve(size_t count);
+	// Processes every running tween
+	// deltaTime used for frame-rate independent tweening
+	// With SetTickRate(), runs as many whole ticks as deltaTime adds up to
+	// Callbacks may create tweens on this manager, those start on the next Update()
+	void Update(float deltaTime);
+	// Counts time in integer ticks of 1 / ticksPerSecond seconds, 0 goes back to float deltaTime
+	// Progress is computed from the ticks each tween has run rather than accumulated,
+	// so the values are the same whether ticks come one by one or at once, on any machine
+	// Update() keeps the time short of a whole tick for the next call
+	// *TweenGroup time scales are ignored in tick mode, pausing a group still applies
+	// *Optional, disabled by default
+	void SetTickRate(unsigned int ticksPerSecond);
+	// Advances time by 'ticks' ticks in a single pass, e.g. to catch up after a hitch or replay
+	// Callbacks run once per call and chained tweens start at the end of it
+	// *Does nothing unless SetTickRate() was called
+	void StepTicks(unsigned int ticks);
+	// Adds a single TweenData
+	// Helper function in case it is needed
+	// Returns the handle of the added tween
+	// Values, callbacks and chains are moved out of an rvalue
+	TweenHandle AddTween(const TweenData<T>& STween);
+	TweenHandle AddTween(TweenData<T>&& STween);
+	// Moves every tween of 'other' to the end of this manager, leaving 'other' empty
+	// Each array is moved in one go, callbacks and chains are never copied
+	// Handles of 'other' expire, GetHandle() returns the last tween moved
+	// *Not to be called from a callback while 'other' is being updated
+	void Splice(STween& other);
+	// Read-only view of the registered tweens in storage order
+	// Nothing is copied, the view is valid until this manager changes
+	// *Tweens waiting for their Delay() are not part of it
+	// *In pull mode progress is where running tweens started from, see Sample() for their value
+	TweenView<T> View() const;
+	// Number of tweens registered, including paused and delayed tweens
+	size_t Size() const;
+	// Returns the handle of the tween being built
+	// TweenHandle h = tweens.From(&x).To(1.0f).Time(0.5f).GetHandle();
+	TweenHandle GetHandle() const;
+	// Returns true while the tween is registered, including paused tweens
+	bool IsAlive(TweenHandle handle) const;
+	// Stops the tween where it is, no callbacks nor chains are triggered
+	// Returns false if the handle had already expired
+	bool Kill(TweenHandle handle);
+	// Freezes the tween until Resume() is called
+	// A tween waiting for its Delay() stops counting it down
+	// Returns false if the handle had already expired
+	bool Pause(TweenHandle handle);
+	// Continues a paused tween
+	// Returns false if the handle had already expired
+	bool Resume(TweenHandle handle);
+	// Moves the tween to 'sec' seconds after its start
+	// The new value is applied on the next Update()
+	// Returns false if the handle had already expired
+	bool Seek(TweenHandle handle, float sec);
+	// Sends a running tween towards 'finalVal' instead, without creating a new one
+	// By default it restarts from its current value for its whole duration, its speed changes
+	// 'keepVelocity' keeps its place on the easing curve and its speed instead, its duration changes
+	// Either way the value has no jump
+	// Tweens going back on a yoyo or reversed get 'finalVal' as the end they head to, loops left are kept
+	// Waiting tweens only get their final value replaced
+	// Returns false if the handle had already expired
+	// *'keepVelocity' restarts instead where the curve is flat or T has no length, see TweenTraits
+	bool Retarget(TweenHandle handle, const T& finalVal, bool keepVelocity = false);
+#ifdef STWEEN_COROUTINES
+	// Awaitable resuming the coroutine once the tween finished or was killed, see TweenAwaiter
+	// co_await tweens.Play(tweens.From(&x).To(1.0f).Time(0.5f).GetHandle());
+	TweenAwaiter<1> Play(TweenHandle handle);
+	// Same for several tweens of this manager, use AllOf(tweens.Play(a), ...) across managers
+	template<class... Handles> TweenAwaiter<sizeof...(Handles)> AllOf(Handles... handles);
+#endif
+	// Lets each pointer target have a single tween: a new tween writing to it kills the previous one
+	// Targets are kept in a hashed index, creating tweens stays O(1)
+	// *Optional, disabled by default
+	void SetCoalesceTargets(bool enabled);
+	// Tween writing to 'target', found through the index of SetCoalesceTargets()
+	// tweens.Retarget(tweens.FindTarget(&x), 1.0f, true);
+	// Returns an invalid handle if there is none or coalescing is disabled
+	TweenHandle FindTarget(const T* target) const;
+	// Computes the current value of the tween
+	// Returns false if the handle had already expired
+	bool Sample(TweenHandle handle, T& value) const;
+	// Computes the value the tween has 'sec' seconds after its start, without changing it
+	// Returns false if the handle had already expired
+	bool SampleAt(TweenHandle handle, float sec, T& value) const;
+	// Tweens only keep the time they started on the clock of their group and the time they finish is in a timer heap,
+	// Update() advances the clocks and finishes the tweens whose time has come, running their callbacks and chains
+	// Values are computed when asked for with Sample(), so a frame costs what is sampled and finished, not what is running
+	// Groups, Pause(), Seek(), loops and ticks behave as in push mode
+	// *Step callbacks are not called and pointer targets only get their final value
+	// *Deferred callbacks, the job system, batched easing, sorted targets, separate writes and the output buffer are not used meanwhile
+	// *Optional, disabled by default, not to be called from a callback while Update() runs
+	void SetPullMode(bool enabled);
+	// Update() evaluates every tween first without running user code,
+	// then calls 'handler' and the step and finish callbacks in a separate pass
+	// Results are also kept in GetUpdatedHandles(), GetUpdatedValues() and GetFinishedHandles()
+	// *Step callbacks receive the value written to the target, the final value once finished
+	// *Optional, disabled by default, 'handler' may be nullptr
+	void SetDeferredCallbacks(bool enabled, TweenBatchHandler<T>* handler = nullptr);
+	// Tweens evaluated by the last Update() with deferred callbacks, same order as GetUpdatedValues()
+	TweenSpan<const TweenHandle> GetUpdatedHandles() const;
+	TweenSpan<const T> GetUpdatedValues() const;
+	// Tweens finished during the last Update() with deferred callbacks
+	TweenSpan<const TweenHandle> GetFinishedHandles() const;
+	// Keeps the tweens ordered by Owner(), then by target address, so targets are written in ascending memory order
+	// Tweens added since the last Update() are merged into place when it starts
+	// *Tweens no longer run in creation order, sorting costs a pass over the tweens on frames where some were added
+	// *Optional, disabled by default
+	void SetSortedTargets(bool enabled);
+	// Update() computes the values first and writes every target in a separate pass afterwards
+	// Keeps the evaluation streaming through the arrays, the writes then go out in storage order
+	// *Step callbacks run before their target is written, finished tweens still write their final value right away
+	// *Optional, disabled by default
+	void SetSeparateWrites(bool enabled);
+	// Tweens created with From(T) also write their value to buffer[handle.index] each frame,
+	// handle being the one GetHandle() returned, so results land in one contiguous array
+	// With SetSortedTargets() these tweens are ordered by handle and the buffer is written front to back
+	// *Handles past the end of 'buffer' are skipped, it must stay valid until replaced, an empty span stops the writes
+	void SetOutputBuffer(TweenSpan<T> buffer);
+	// Groups running tweens by EasingFunction and evaluates each group in one batch
+	// Uses SSE/AVX/NEON when available, worth it with large amounts of tweens
+	// *Optional, disabled by default
+	void SetBatchedEasing(bool enabled);
+	// Evaluates easing through baked samples instead of the exact curves
+	// Combines with SetBatchedEasing()
+	// *The tables must outlive this manager
+	// *Optional, nullptr goes back to the exact curves
+	void SetSampledEasing(const SampledEasing* sampledEasing);
+	// Evaluates values and writes pointer targets in parallel through the job system
+	// Step and finish callbacks and chains still run in order on the thread calling Update()
+	// Only used when there are more than 'grain' tweens, which is also the size of each job
+	// *Pointer targets must not be shared between tweens nor read by other threads meanwhile
+	// *Optional, nullptr goes back to the serial update
+	void SetJobSystem(TweenJobSystem* jobSystem, size_t grain = 4096);
+	// Adds the tweens submitted to 'queue' from any thread at the start of each Update()
+	// Update() stays the only writer of this manager, submitted tweens get their handles there
+	// *The queue must outlive this manager or be replaced first
+	// *Optional, nullptr stops draining
+	void SetSubmitQueue(TweenSubmitQueue<T, Alloc>* queue);
+#ifdef STWEEN_TRACK_ALLOCATIONS
+	// Returns how many times the tween storage had to grow during the last Update()
+	// Steady state is 0 once the arrays have reached their peak size
+	// *Only counts STween's own containers, not memory allocated by user callbacks
+	size_t GetUpdateAllocations() const;
+#endif
+#ifdef STWEEN_STATS
+	// Counters and phase timings of the last Update()
+	// *Step callbacks are timed one by one, which adds clock reads to every step
+	const TweenStats& GetStats() const;
+#endif
+private:
+	// Callbacks, sequence, delay, loops and owner of a tween, defined with the arrays below
+	struct TweenCold;
+	struct TweenWake;
+	// Where a tween is within its plays, see PlayOf()
+	struct PlayState
+	{
+		float progress;
+		unsigned char flags;
+		// TweenCold::loops, only read with FlagLoop
+		unsigned int loops;
+	};
+
+	// Appends a tween to every array and makes it the current one
+	void PushTween(T* target, const T& initVal);
+	// Copy and assignment, takes the tweens and settings of 'other'
+	void CopyFrom(const STween& other);
+	// ReleaseTweens() without emptying the arrays: expires every handle, drops parked tweens and groups
+	void ReleaseReferences();
+	// Takes a free handle slot for the tween at index
+	unsigned int AcquireSlot(size_t index);
+	// Moves the tween at index 'from' to index 'to'
+	void MoveTween(size_t from, size_t to);
+	// Returns the slot of the tween at index, making both handles expire
+	void ReleaseSlot(size_t index);
+	// Makes every handle of the slot expire and returns it to the free list
+	void FreeSlot(unsigned int slot);
+	// Returns the storage index of a live handle, NoIndex otherwise
+	unsigned int IndexOf(TweenHandle handle) const;
+	// Returns the index in m_parked of a delayed tween, NoIndex otherwise
+	unsigned int ParkedIndexOf(TweenHandle handle) const;
+	// Returns the storage holding a live handle, this or m_parked, nullptr if expired
+	STween* Locate(TweenHandle handle, unsigned int& index);
+	// Moves the tweens flagged by Delay() to m_parked
+	void ParkDelayed();
+	// Adds an entry for the tween of 'slot' at 'time' to a timer heap of m_wakeHeaps or m_finishHeaps
+	void PushTimer(TweenVector<TweenWake, Alloc>& heap, unsigned int slot, double time);
+	// Returns true if a timer heap has an entry whose time has come
+	bool HasDueWakes() const;
+	// Moves the delayed tweens whose wait is over back to the arrays
+	void WakeDelayed();
+	// Moves every waiting tween back to the arrays, delay left in their cold data
+	void UnparkAll();
+	// Removes a tween from m_parked, the last one takes its place
+	void RemoveParked(size_t index);
+	// Delay left for the tween at index of 'storage', 0 once started
+	float DelayOf(const STween& storage, size_t index) const;
+	// Value of the tween at index of 'storage', this or m_parked, at 'progress' going the way 'reversed' says
+	T ValueAt(const STween& storage, size_t index, float progress, bool reversed) const;
+	// Progress, flags and loops of the tween at index of 'storage', this or m_parked,
+	// worked out from its start time for pulled tweens as Update() would have left them in push mode
+	PlayState PlayOf(const STween& storage, size_t index) const;
+	// True if the tween at index runs from a start time, see SetPullMode()
+	bool IsPulled(size_t index) const;
+	// Gives the tween at index a start time from its progress and pushes the entry finishing it
+	void StartPulled(size_t index);
+	// Start times for the tweens added since the last Update(), in pull mode
+	void StartAddedPulled();
+	// Writes back the progress, direction and loops of a pulled tween so it can be changed as in push mode
+	void StopPulled(size_t index);
+	// StopPulled() for every pulled tween, dropping the finished and killed ones first and emptying the finish heaps
+	void StopAllPulled();
+	// Time the pulled tween at index ends its last play on the clock of its group, false if it loops forever
+	bool FinishTimeOf(size_t index, double& time) const;
+	// Finishes the pulled tweens whose time has come, their callbacks and chains run as they are reached
+	void FinishPulled();
+	// Counts the tween at index as finished or killed for ReclaimPulled()
+	void PushDead(size_t index);
+	// Drops finished and killed tweens in pull mode, the last tween takes the place of each one
+	void ReclaimPulled();
+	// Converts the tween at index of 'storage', this or m_parked, to the TweenData interchange format
+	TweenData<T> ToData(const STween& storage, size_t index) const;
+	// Appends the tween at index of 'storage', this or m_parked, to a sequence
+	void AppendToSequence(TweenSequence<T, Alloc>& sequence, const STween& storage, size_t index) const;
+	// Returns the entry of 'group' in m_groupRefs, counting one more tween using it
+	unsigned int AcquireGroup(const TweenGroup* group);
+	// Counts one tween less using the entry, freed once unused
+	void ReleaseGroup(unsigned int group);
+	// Returns the cold data of the tween at index, a default one if it has none
+	const TweenCold& ColdOf(size_t index) const;
+	// Returns the cold data of the tween at index for writing, taking a pool entry if it has none
+	TweenCold& OwnCold(size_t index);
+	// Returns the pool entry of the tween at index, if any, to the free list
+	void FreeCold(size_t index);
+	// Moves the pool entry of the tween at sourceIndex of 'source' to the tween at index, after its columns were moved here
+	void AdoptCold(STween& source, size_t sourceIndex, size_t index);
+	// Returns the callbacks of the tween at index, own or borrowed
+	const TweenCallbacks<T, Alloc>& CallbacksOf(size_t index) const;
+	// Returns the callbacks of the tween at index for writing
+	// Borrowed callbacks are copied first
+	TweenCallbacks<T, Alloc>& OwnCallbacks(size_t index);
+	// Call the callbacks of the tween at index from locals, never from m_coldPool,
+	// so the tweens they create may grow the pool while they run
+	void RunStepCallback(size_t index, T& value);
+	void RunFinishCallback(size_t index);
+	// Appends every tween of the sequence, borrowing its callbacks
+	void StartSequence(const std::shared_ptr<const TweenSequence<T, Alloc>>& sequence);
+	// Conversions between sequences and the TweenData interchange format
+	static std::vector<TweenData<T>> SequenceToData(const TweenSequence<T, Alloc>& sequence);
+	// Callbacks are moved out of rvalue containers
+	template<class Tweens> std::shared_ptr<const TweenSequence<T, Alloc>> DataToSequence(Tweens&& tweens) const;
+	// Drops every tween at or after index 'count'
+	void TruncateTweens(size_t count);
+	// Applies 'visitor' to every per-tween array
+	template<class Visitor> void ForEachColumn(Visitor& visitor);
+	// Applies 'visitor' to every per-tween array paired with the same array of 'other'
+	template<class Visitor> void ForEachColumnPair(STween& other, Visitor& visitor);
+	// Shared by both AddTween() overloads
+	template<class Data> TweenHandle AddTweenData(Data&& tween);
+	// Writes the tween at index of 'storage', this or m_parked, as entry 'entry' of a snapshot
+	template<class TargetId> void WriteSnapshotEntry(const STween& storage, size_t index, size_t entry, unsigned char* data, const Detail::SnapshotLayout& layout, TargetId& targetId) const;
+	// Sets the duration and the time already elapsed of the tween at index
+	void SetTiming(size_t index, float duration, float elapsed);
+	// Update() and StepTicks(), 'ticks' is only used in tick mode
+	// Runs the kernels below in order, a TweenWorld runs each over all its managers before the next
+	void Advance(float deltaTime, unsigned int ticks);
+	// Takes submitted tweens, parks and wakes delayed ones against the clock and sorts targets
+	void ScheduleTweens();
+	// Advances and writes every running tween, callbacks and chains run as they are reached
+	void EvaluateTweens(float deltaTime, unsigned int ticks);
+	// Drops finished tweens and resumes their waiters, once the clock has moved
+	void FinishTweens();
+	// Moves the clock of each group by its deltaTime of this Update(), after the tweens
+	void AdvanceGroups(unsigned int ticks);
+	// m_sharedClock if set, m_ownClock otherwise
+	Detail::TweenClock& Clock();
+	const Detail::TweenClock& Clock() const;
+	// Rounds the progress of the tween at index to whole ticks, in tick mode
+	void AnchorTicks(size_t index);
+	// AnchorTicks() for every running tween, after the tick rate of the clock changed
+	void AnchorAllTicks();
+	// Progress of the tween at index from its ticks
+	float TickProgress(size_t index) const;
+	// Moves the progress of the running tween at index forward by one Update() or StepTicks()
+	void StepTween(size_t index, unsigned char flags, float progress, unsigned int ticks);
+	// Wraps the progress of a looping tween that went past its end
+	void WrapLoop(size_t index);
+	// Wraps 'play' past the end of its current play, counting down its loops and turning yoyos around
+	static void WrapPlays(PlayState& play);
+	// Sets the progress, flags and loops of the tween at index, resolving its values again if it turned around
+	void ApplyPlay(size_t index, const PlayState& play);
+	// Sets how many times the tween at index starts over, LoopsForever until killed
+	void SetLoops(size_t index, unsigned int loops, bool yoyo);
+	// Loops of TweenData in the encoding of TweenCold, 0 for none
+	static unsigned int EncodeLoops(unsigned int loops, bool yoyo);
+	// Recomputes the base and delta of the tween at index from its start, end and direction
+	void ResolveValues(size_t index);
+	// Returns the value of the tween at index for its current time
+	T Evaluate(size_t index) const;
+	// TweenJobSystem job evaluating the tweens in [begin, end)
+	static void EvaluateJob(void* context, size_t begin, size_t end);
+	// Update() loop over the first 'count' tweens, callbacks run as each tween is reached
+	// Running tweens without step callback take the short path, the others go through UpdateTween()
+	template<bool Parallel, bool SeparateWrites> void UpdateImmediate(size_t count, unsigned int ticks);
+	// Paused, stepping with a callback, finishing and killed tweens of UpdateImmediate()
+	template<bool Parallel, bool SeparateWrites> void UpdateTween(size_t index, unsigned char flags, float progress, unsigned int ticks);
+	// Writes the final value of the tween at index to 'target', expires its handle and runs its finish callback and chain
+	void FinishTween(size_t index, unsigned char flags, T* target);
+	// Writes the value of the tween at index to its target, or queues it with SetSeparateWrites(), and returns it
+	template<bool Parallel, bool SeparateWrites> T WriteValue(size_t index, T* target, float progress);
+	// Update() loop over the first 'count' tweens with deferred callbacks
+	void UpdateDeferred(size_t count, bool parallel, unsigned int ticks);
+	// Drops finished and killed tweens, the others are moved towards the front in order
+	void CompactTweens();
+	// Handle of the tween at index, invalid if it has none
+	TweenHandle HandleOf(size_t index) const;
+	// TweenAwaitEntry::link of this manager, adds 'node' to the waiters of the slot of 'handle'
+	static bool LinkWaiter(void* manager, TweenHandle handle, TweenWaitNode& node);
+	// Counts down the waiters of a slot being freed, queueing the ones with nothing left to wait for
+	void ExpireWaiters(unsigned int slot);
+	// Resumes the queued waiters at the end of Update()
+	void ResumeWaiters();
+	// Adds the tweens of m_submitQueue at the start of Update()
+	void DrainSubmitted();
+	// Where the tween at index writes its value: its pointer target, its SetOutputBuffer() entry or nullptr
+	T* TargetOf(size_t index) const;
+	// Merges the tweens added since the last sort into place, see SetSortedTargets()
+	void SortTargets();
+	// Exchanges the tweens at a and b in storage
+	void SwapTweens(size_t a, size_t b);
+	// Makes 'handle' the only tween of 'target', killing the one it had
+	void ClaimTarget(const T* target, TweenHandle handle);
+	// Clears the target index and fills it back from the running and waiting tweens
+	// Sized so at most a quarter of it is used afterwards
+	void RebuildTargetIndex();
+	// Fills m_eased with the eased factor of the first 'count' tweens, batched by easing function
+	void EaseBatched(size_t count);
+	// Resizes a scratch buffer used by Update()
+	template<class Buffer> void ResizeScratch(Buffer& buffer, size_t size);
+
+private:
+	// Read the flags stored in sequences
+	template <class, class> friend class TweenTimeline;
+	template <class, class> friend class CompactTweenGroup;
+	// Runs the kernels of Advance() on its shared clock
+	template <class> friend class TweenWorld;
+
+	// Bits stored in m_flags
+	enum TweenFlag : unsigned char
+	{
+		FlagReady = 1 << 0,
+		FlagReversed = 1 << 1,
+		FlagFinishCallback = 1 << 2,
+		FlagStepCallback = 1 << 3,
+		FlagChain = 1 << 4,
+		FlagPaused = 1 << 5,
+		FlagDelayed = 1 << 6,
+		FlagLoop = 1 << 7
+	};
+
+	static const unsigned int NoIndex = ~0u;
+	// Set in TweenSlot::index for delayed tweens, the rest is their index in m_parked
+	static const unsigned int ParkedBit = 1u << 31;
+	// Set in TweenCold::loops for Yoyo(), the rest is the loops left
+	static const unsigned int YoyoBit = 1u << 31;
+	static const unsigned int LoopsForever = ~0u >> 1;
+
+	// Group used by tweens of this manager, entry 0 stands for no group
+	struct GroupRef
+	{
+		const TweenGroup* group;
+		size_t users;
+		// Seconds the group has run on this manager, delays wait on it
+		double time;
+	};
+
+	// Timer heap entry of a delayed tween, or of the finish of a pulled one
+	struct TweenWake
+	{
+		double time;
+		unsigned int slot;
+		unsigned int generation;
+	};
+
+	// Orders a timer heap as a min-heap
+	struct WakesLater
+	{
+		bool operator()(const TweenWake& a, const TweenWake& b) const { return a.time > b.time; }
+	};
+
+	// Slot map entry
+	// 'index' is the storage index while the slot is used,
+	// the next free slot otherwise
+	struct TweenSlot
+	{
+		unsigned int index;
+		unsigned int generation;
+	};
+
+	Alloc m_allocator;
+	int m_lastTweenIndex;
+	typedef typename Detail::DeltaOf<T>::type Delta;
+
+	// Hot data, one entry per tween, read every frame
+	// Normalized position, the tween finishes once it reaches 1
+	TweenVector<float, Alloc> m_progress;
+	// 1 / duration, 0 for tweens without duration which start at progress 1
+	TweenVector<float, Alloc> m_invDuration;
+	// Value at progress 0 and change over the whole tween, Reversed() already applied
+	TweenVector<T, Alloc> m_base;
+	TweenVector<Delta, Alloc> m_delta;
+	TweenVector<EasingFunction, Alloc> m_easing;
+	TweenVector<T*, Alloc> m_target;
+	TweenVector<unsigned char, Alloc> m_flags;
+	TweenVector<unsigned int, Alloc> m_slotOf;
+	// Index in m_groupRefs
+	TweenVector<unsigned int, Alloc> m_group;
+	// Ticks run, only kept up to date in tick mode
+	TweenVector<unsigned int, Alloc> m_ticks;
+	// Time on the clock of its group the tween had progress 0, only kept for pulled tweens
+	TweenVector<double, Alloc> m_startTime;
+	// Warm data, read when tweens are built, finish or are exported
+	TweenVector<float, Alloc> m_duration;
+	TweenVector<T, Alloc> m_start;
+	TweenVector<T, Alloc> m_end;
+	// Cold data of a tween
+	// Tweens started by a chain borrow the callbacks stored in the sequence
+	struct TweenCold
+	{
+		TweenCold()
+			:sourceIndex(0),
+			delay(0),
+			loops(0),
+			owner(0)
+		{}
+
+		TweenCallbacks<T, Alloc> callbacks;
+		std::shared_ptr<const TweenSequence<T, Alloc>> source;
+		unsigned int sourceIndex;
+		// Set by Delay() until the tween is parked
+		float delay;
+		// Times the tween starts over, only read with FlagLoop
+		unsigned int loops;
+		// Set by Owner()
+		unsigned int owner;
+	};
+
+	// Cold data, only touched when the matching flag is set
+	// Pooled so tweens without any only pay for m_coldOf, entry + 1 of each tween, 0 for none
+	TweenVector<unsigned int, Alloc> m_coldOf;
+	TweenVector<TweenCold, Alloc> m_coldPool;
+	TweenVector<unsigned int, Alloc> m_freeCold;
+	// Handle slots, indices are stable so handles never move
+	TweenVector<TweenSlot, Alloc> m_slots;
+	unsigned int m_freeSlot;
+	// Time of Update(), used for delays and ticks
+	// m_ownClock unless a TweenWorld shares its own through m_sharedClock
+	Detail::TweenClock m_ownClock;
+	Detail::TweenClock* m_sharedClock;
+	// Delayed tweens, only their arrays are used and m_slotOf is in this manager's slots
+	// Created the first time a tween is delayed
+	std::shared_ptr<STween> m_parked;
+	// Timer heap of each entry of m_groupRefs, same index, wake times are on the clock of that group
+	TweenVector<TweenVector<TweenWake, Alloc>, Alloc> m_wakeHeaps;
+	// Wake time of each tween of m_parked, same index, so the delay left is read without searching the heap
+	// Paused tweens keep the delay left instead and have no heap entry until resumed
+	TweenVector<double, Alloc> m_parkedWake;
+	// Delay() was called since the last Update()
+	bool m_hasPendingDelays;
+	// Groups in use and their deltaTime, computed once per Update()
+	TweenVector<GroupRef, Alloc> m_groupRefs;
+	TweenVector<float, Alloc> m_groupDelta;
+	// Scratch buffers for batched easing, kept between updates
+	bool m_batchedEasing;
+	const SampledEasing* m_sampledEasing;
+	// Pull mode, tweens before m_pulledCount have a start time, the ones after were added since the last Update()
+	bool m_pullMode;
+	size_t m_pulledCount;
+	// Time each pulled tween ends on the clock of its group, one heap per entry of m_groupRefs
+	TweenVector<TweenVector<TweenWake, Alloc>, Alloc> m_finishHeaps;
+	// Finished and killed tweens left for ReclaimPulled()
+	TweenVector<unsigned int, Alloc> m_pulledDead;
+	TweenVector<unsigned int, Alloc> m_easeOrder;
+	TweenVector<float, Alloc> m_easeBuffer;
+	TweenVector<float, Alloc> m_eased;
+	TweenVector<size_t, Alloc> m_bucketStart;
+	TweenVector<size_t, Alloc> m_bucketFill;
+	// Parallel evaluation
+	TweenJobSystem* m_jobSystem;
+	size_t m_parallelGrain;
+	TweenVector<T, Alloc> m_values;
+	// Deferred callbacks, the first m_updatedCount and m_finishedCount entries are the last Update()
+	bool m_deferredCallbacks;
+	TweenBatchHandler<T>* m_batchHandler;
+	TweenVector<TweenHandle, Alloc> m_updatedHandles;
+	TweenVector<T, Alloc> m_updatedValues;
+	TweenVector<unsigned int, Alloc> m_updatedIndex;
+	size_t m_updatedCount;
+	TweenVector<TweenHandle, Alloc> m_finishedHandles;
+	TweenVector<unsigned int, Alloc> m_finishedIndex;
+	size_t m_finishedCount;
+	// Target index, open addressing over a power of two table, see SetCoalesceTargets()
+	// Entries of finished tweens stay until reused or the next rebuild
+	struct TargetEntry
+	{
+		const T* target;
+		TweenHandle handle;
+	};
+	bool m_coalesceTargets;
+	TweenVector<TargetEntry, Alloc> m_targetIndex;
+	size_t m_targetEntries;
+	// Target ordering, see SetSortedTargets()
+	struct SortKey
+	{
+		unsigned int owner;
+		const T* target;
+		unsigned int slot;
+		unsigned int index;
+	};
+	// Orders SortKey by owner, target then handle
+	struct SortsBefore
+	{
+		bool operator()(const SortKey& a, const SortKey& b) const
+		{
+			if (a.owner != b.owner)
+				return a.owner < b.owner;
+			if (a.target != b.target)
+				return std::less<const T*>()(a.target, b.target);
+			return a.slot < b.slot;
+		}
+	};
+	bool m_sortedTargets;
+	// Tweens were added since the last sort
+	bool m_hasUnsortedTargets;
+	TweenVector<SortKey, Alloc> m_sortKeys;
+	TweenVector<SortKey, Alloc> m_sortMerged;
+	// Writes left for the pass after evaluation, see SetSeparateWrites()
+	bool m_separateWrites;
+	TweenVector<T*, Alloc> m_writeTargets;
+	TweenVector<T, Alloc> m_writeValues;
+	size_t m_writeCount;
+	TweenSpan<T> m_outputBuffer;
+	// Waiters of each handle slot, sized on the first wait
+	TweenVector<TweenWaitNode*, Alloc> m_slotWaiters;
+	// Waiters to resume at the end of Update(), in the order their tweens expired
+	TweenWaiter* m_readyWaiters;
+	TweenWaiter* m_lastReadyWaiter;
+	// Tweens started from other threads, see SetSubmitQueue()
+	TweenSubmitQueue<T, Alloc>* m_submitQueue;
+#ifdef STWEEN_TRACK_ALLOCATIONS
+	size_t m_allocationCount;
+	size_t m_updateAllocations;
+	// m_allocationCount when Update() started, read once its kernels are done
+	size_t m_allocationsBefore;
+#endif
+#ifdef STWEEN_STATS
+	TweenStats m_stats;
+#endif
+};
+
+template<class T, class Alloc>STween<T, Alloc>::STween(const Alloc& alloc)
+	:m_allocator(alloc),
+	m_lastTweenIndex(-1),
+	m_progress(alloc),
+	m_invDuration(alloc),
+	m_base(alloc),
+	m_delta(alloc),
+	m_easing(alloc),
+	m_target(alloc),
+	m_flags(alloc),
+	m_slotOf(alloc),
+	m_group(alloc),
+	m_ticks(alloc),
+	m_startTime(alloc),
+	m_duration(alloc),
+	m_start(alloc),
+	m_end(alloc),
+	m_coldOf(alloc),
+	m_coldPool(alloc),
+	m_freeCold(alloc),
+	m_slots(alloc),
+	m_freeSlot(NoIndex),
+	m_ownClock(),
+	m_sharedClock(nullptr),
+	m_wakeHeaps(1, TweenVector<TweenWake, Alloc>(alloc), alloc),
+	m_parkedWake(alloc),
+	m_hasPendingDelays(false),
+	m_groupRefs(1, GroupRef(), alloc),
+	m_groupDelta(alloc),
+	m_batchedEasing(false),
+	m_sampledEasing(nullptr),
+	m_pullMode(false),
+	m_pulledCount(0),
+	m_finishHeaps(1, TweenVector<TweenWake, Alloc>(alloc), alloc),
+	m_pulledDead(alloc),
+	m_easeOrder(alloc),
+	m_easeBuffer(alloc),
+	m_eased(alloc),
+	m_bucketStart(alloc),
+	m_bucketFill(alloc),
+	m_jobSystem(nullptr),
+	m_parallelGrain(4096),
+	m_values(alloc),
+	m_deferredCallbacks(false),
+	m_batchHandler(nullptr),
+	m_updatedHandles(alloc),
+	m_updatedValues(alloc),
+	m_updatedIndex(alloc),
+	m_updatedCount(0),
+	m_finishedHandles(alloc),
+	m_finishedIndex(alloc),
+	m_finishedCount(0),
+	m_coalesceTargets(false),
+	m_targetIndex(alloc),
+	m_targetEntries(0),
+	m_sortedTargets(false),
+	m_hasUnsortedTargets(false),
+	m_sortKeys(alloc),
+	m_sortMerged(alloc),
+	m_separateWrites(false),
+	m_writeTargets(alloc),
+	m_writeValues(alloc),
+	m_writeCount(0),
+	m_outputBuffer(),
+	m_slotWaiters(alloc),
+	m_readyWaiters(nullptr),
+	m_lastReadyWaiter(nullptr),
+	m_submitQueue(nullptr)
+#ifdef STWEEN_TRACK_ALLOCATIONS
+	,m_allocationCount(0)
+	,m_updateAllocations(0)
+	,m_allocationsBefore(0)
+#endif
+#ifdef STWEEN_STATS
+	,m_stats()
+#endif
+{}
+
+template<class T, class Alloc>STween<T, Alloc>::STween(const STween& other)
+	:STween(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.m_allocator))
+{
+	CopyFrom(other);
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::operator=(const STween& other)
+{
+	if (this != &other)
+	{
+		ReleaseTweens();
+		CopyFrom(other);
+	}
+
+	return *this;
+}
+
+template<class T, class Alloc>STween<T, Alloc>::~STween()
+{}
+
+template<class T, class Alloc> void STween<T, Alloc>::CopyFrom(const STween& other)
+{
+	m_lastTweenIndex = other.m_lastTweenIndex;
+	// ColumnAssign only reads 'other'
+	Detail::ColumnAssign assign;
+	ForEachColumnPair(const_cast<STween&>(other), assign);
+	m_coldPool = other.m_coldPool;
+	m_freeCold = other.m_freeCold;
+	m_slots = other.m_slots;
+	m_freeSlot = other.m_freeSlot;
+
+	// Delayed tweens get storage of their own, a shared one would let either manager free the other's tweens
+	if (other.m_parked)
+	{
+		if (!m_parked)
+		{
+			m_parked = std::allocate_shared<STween>(m_allocator, m_allocator);
+		}
+		m_parked->CopyFrom(*other.m_parked);
+	}
+	// Wake times are on the group clocks, copied along with the groups
+	m_wakeHeaps = other.m_wakeHeaps;
+	m_parkedWake = other.m_parkedWake;
+	m_hasPendingDelays = other.m_hasPendingDelays;
+	if (!m_sharedClock)
+	{
+		m_ownClock = other.Clock();
+	}
+
+	m_groupRefs = other.m_groupRefs;
+	m_batchedEasing = other.m_batchedEasing;
+	m_sampledEasing = other.m_sampledEasing;
+	m_pullMode = other.m_pullMode;
+	m_pulledCount = other.m_pulledCount;
+	m_finishHeaps = other.m_finishHeaps;
+	m_pulledDead = other.m_pulledDead;
+	m_jobSystem = other.m_jobSystem;
+	m_parallelGrain = other.m_parallelGrain;
+	m_deferredCallbacks = other.m_deferredCallbacks;
+	m_batchHandler = other.m_batchHandler;
+	m_updatedHandles = other.m_updatedHandles;
+	m_updatedValues = other.m_updatedValues;
+	m_updatedIndex = other.m_updatedIndex;
+	m_updatedCount = other.m_updatedCount;
+	m_finishedHandles = other.m_finishedHandles;
+	m_finishedIndex = other.m_finishedIndex;
+	m_finishedCount = other.m_finishedCount;
+	m_coalesceTargets = other.m_coalesceTargets;
+	m_targetIndex = other.m_targetIndex;
+	m_targetEntries = other.m_targetEntries;
+	m_sortedTargets = other.m_sortedTargets;
+	m_hasUnsortedTargets = other.m_hasUnsortedTargets;
+	m_sortKeys = other.m_sortKeys;
+	m_separateWrites = other.m_separateWrites;
+	m_outputBuffer = other.m_outputBuffer;
+	// Other scratch buffers are refilled by the next Update(),
+	// awaiters and the submit queue stay with the manager they were given to
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::ReleaseTweens()
+{
+	ReleaseReferences();
+	TruncateTweens(0);
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::ReleaseReferences()
+{
+	for (size_t i = 0; i < m_slotOf.size(); ++i)
+	{
+		ReleaseSlot(i);
+	}
+	const TargetEntry empty = { nullptr, TweenHandle() };
+	std::fill(m_targetIndex.begin(), m_targetIndex.end(), empty);
+	m_targetEntries = 0;
+
+	if (m_parked)
+	{
+		for (size_t i = 0; i < m_parked->m_slotOf.size(); ++i)
+		{
+			FreeSlot(m_parked->m_slotOf[i]);
+		}
+		m_parked->TruncateTweens(0);
+	}
+	m_wakeHeaps[0].clear();
+	m_wakeHeaps.erase(m_wakeHeaps.begin() + 1, m_wakeHeaps.end());
+	m_parkedWake.clear();
+	m_hasPendingDelays = false;
+	m_finishHeaps[0].clear();
+	m_finishHeaps.erase(m_finishHeaps.begin() + 1, m_finishHeaps.end());
+	m_pulledDead.clear();
+	m_pulledCount = 0;
+	m_groupRefs.resize(1);
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::PushTween(T* target, const T& initVal)
+{
+#ifdef STWEEN_TRACK_ALLOCATIONS
+	Detail::ColumnGrowth growth = { 0 };
+	ForEachColumn(growth);
+	m_allocationCount += growth.count;
+#endif
+
+	Detail::ColumnPush push;
+	ForEachColumn(push);
+	m_lastTweenIndex++;
+
+	const size_t index = m_lastTweenIndex;
+	m_start[index] = initVal;
+	m_end[index] = initVal;
+	m_easing[index] = EasingFunction::Linear;
+	m_target[index] = target;
+	m_flags[index] = FlagReady;
+	m_slotOf[index] = AcquireSlot(index);
+	m_group[index] = 0;
+	SetTiming(index, 0, 0);
+	ResolveValues(index);
+	m_hasUnsortedTargets = true;
+
+	if (m_coalesceTargets && target)
+	{
+		ClaimTarget(target, HandleOf(index));
+	}
+}
+
+template<class T, class Alloc> unsigned int STween<T, Alloc>::AcquireSlot(size_t index)
+{
+	unsigned int slot = m_freeSlot;
+	if (slot != NoIndex)
+	{
+		m_freeSlot = m_slots[slot].index;
+	}
+	else
+	{
+#ifdef STWEEN_TRACK_ALLOCATIONS
+		m_allocationCount += m_slots.size() == m_slots.capacity();
+#endif
+		slot = static_cast<unsigned int>(m_slots.size());
+		TweenSlot newSlot = { 0, 1 };
+		m_slots.push_back(newSlot);
+	}
+	m_slots[slot].index = static_cast<unsigned int>(index);
+
+	return slot;
+}
+
+template<class T, class Alloc> template<class Visitor> void STween<T, Alloc>::ForEachColumn(Visitor& visitor)
+{
+	Detail::FirstColumn<Visitor> first = { visitor };
+	ForEachColumnPair(*this, first);
+}
+
+template<class T, class Alloc> template<class Visitor> void STween<T, Alloc>::ForEachColumnPair(STween& other, Visitor& visitor)
+{
+	visitor(m_progress, other.m_progress);
+	visitor(m_invDuration, other.m_invDuration);
+	visitor(m_base, other.m_base);
+	visitor(m_delta, other.m_delta);
+	visitor(m_easing, other.m_easing);
+	visitor(m_target, other.m_target);
+	visitor(m_flags, other.m_flags);
+	visitor(m_slotOf, other.m_slotOf);
+	visitor(m_group, other.m_group);
+	visitor(m_ticks, other.m_ticks);
+	visitor(m_startTime, other.m_startTime);
+	visitor(m_duration, other.m_duration);
+	visitor(m_start, other.m_start);
+	visitor(m_end, other.m_end);
+	visitor(m_coldOf, other.m_coldOf);
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::SetTiming(size_t index, float duration, float elapsed)
+{
+	m_duration[index] = duration;
+	if (duration > 0)
+	{
+		m_invDuration[index] = 1.0f / duration;
+		m_progress[index] = elapsed * m_invDuration[index];
+	}
+	else
+	{
+		// Finishes on the next Update() without dividing by zero
+		m_invDuration[index] = 0;
+		m_progress[index] = 1.0f;
+	}
+	AnchorTicks(index);
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::AnchorTicks(size_t index)
+{
+	const unsigned int tickRate = Clock().tickRate;
+	if (!tickRate)
+	{
+		return;
+	}
+
+	const double ticks = static_cast<double>(m_progress[index]) * m_duration[index] * tickRate + 0.5;
+	m_ticks[index] = ticks > 0 ? static_cast<unsigned int>(ticks) : 0;
+	m_progress[index] = TickProgress(index);
+}
+
+template<class T, class Alloc>float STween<T, Alloc>::TickProgress(size_t index) const
+{
+	if (m_invDuration[index] <= 0)
+	{
+		return 1.0f;
+	}
+
+	return static_cast<float>(m_ticks[index] * Clock().tickSeconds * m_invDuration[index]);
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::StepTween(size_t index, unsigned char flags, float progress, unsigned int ticks)
+{
+	// Only tick mode passes ticks, a call with none moves nothing either way
+	if (ticks)
+	{
+		// Paused groups have no deltaTime and their tweens don't tick
+		m_ticks[index] += m_groupDelta[m_group[index]] != 0 ? ticks : 0;
+		m_progress[index] = TickProgress(index);
+	}
+	else
+	{
+		m_progress[index] = progress + m_groupDelta[m_group[index]] * m_invDuration[index];
+	}
+
+	if ((flags & FlagLoop) && m_progress[index] >= 1.0f)
+	{
+		WrapLoop(index);
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::WrapLoop(size_t index)
+{
+	// Tweens without duration would start over forever
+	if (m_invDuration[index] <= 0)
+	{
+		m_flags[index] &= ~FlagLoop;
+		return;
+	}
+
+	PlayState play = { m_progress[index], m_flags[index], OwnCold(index).loops };
+	WrapPlays(play);
+	ApplyPlay(index, play);
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::WrapPlays(PlayState& play)
+{
+	const unsigned int left = play.loops & ~YoyoBit;
+	// Several plays may end at once after a long frame or a tick catch-up
+	float wraps = std::floor(play.progress);
+	if (left != LoopsForever && wraps > static_cast<float>(left))
+	{
+		// Went past the end of its last play, finishes on the next Update()
+		wraps = static_cast<float>(left);
+		play.loops &= YoyoBit;
+		play.flags &= ~FlagLoop;
+		play.progress = 1.0f;
+	}
+	else
+	{
+		if (left != LoopsForever)
+		{
+			play.loops -= static_cast<unsigned int>(wraps);
+			if (!(play.loops & ~YoyoBit))
+				play.flags &= ~FlagLoop;
+		}
+		play.progress -= wraps;
+	}
+
+	if ((play.loops & YoyoBit) && std::fmod(wraps, 2.0f) != 0)
+	{
+		play.flags ^= FlagReversed;
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::ApplyPlay(size_t index, const PlayState& play)
+{
+	const bool turned = ((play.flags ^ m_flags[index]) & FlagReversed) != 0;
+	if (m_flags[index] & FlagLoop)
+	{
+		OwnCold(index).loops = play.loops;
+	}
+	m_progress[index] = play.progress;
+	m_flags[index] = play.flags;
+	if (turned)
+	{
+		ResolveValues(index);
+	}
+	if (play.progress < 1.0f)
+	{
+		AnchorTicks(index);
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::SetLoops(size_t index, unsigned int loops, bool yoyo)
+{
+	if (loops)
+	{
+		m_flags[index] |= FlagLoop;
+		OwnCold(index).loops = loops | (yoyo ? YoyoBit : 0);
+	}
+	else
+	{
+		m_flags[index] &= ~FlagLoop;
+	}
+}
+
+template<class T, class Alloc>unsigned int STween<T, Alloc>::EncodeLoops(unsigned int loops, bool yoyo)
+{
+	if (!loops)
+	{
+		return 0;
+	}
+
+	return (loops == ~0u ? LoopsForever : std::min(loops, LoopsForever - 1)) | (yoyo ? YoyoBit : 0);
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::ResolveValues(size_t index)
+{
+	if (m_flags[index] & FlagReversed)
+	{
+		Detail::Lanes<T>::Resolve(m_end[index], m_start[index], m_base[index], m_delta[index]);
+	}
+	else
+	{
+		Detail::Lanes<T>::Resolve(m_start[index], m_end[index], m_base[index], m_delta[index]);
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::MoveTween(size_t from, size_t to)
+{
+	Detail::ColumnMove move = { from, to };
+	ForEachColumn(move);
+	// The pool entry now belongs to 'to' only
+	m_coldOf[from] = 0;
+
+	if (m_slotOf[to] != NoIndex)
+	{
+		m_slots[m_slotOf[to]].index = static_cast<unsigned int>(to);
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::ReleaseSlot(size_t index)
+{
+	const unsigned int slot = m_slotOf[index];
+	if (slot == NoIndex)
+	{
+		return;
+	}
+
+	FreeSlot(slot);
+	m_slotOf[index] = NoIndex;
+}
+
+template<class T, class Alloc> unsigned int STween<T, Alloc>::AcquireGroup(const TweenGroup* group)
+{
+	if (!group)
+	{
+		return 0;
+	}
+
+	unsigned int unused = 0;
+	for (unsigned int k = 1; k < m_groupRefs.size(); ++k)
+	{
+		if (m_groupRefs[k].group == group)
+		{
+			++m_groupRefs[k].users;
+			return k;
+		}
+
+		if (!m_groupRefs[k].users && !unused)
+		{
+			unused = k;
+		}
+	}
+
+	if (!unused)
+	{
+#ifdef STWEEN_TRACK_ALLOCATIONS
+		m_allocationCount += m_groupRefs.size() == m_groupRefs.capacity();
+		m_allocationCount += m_wakeHeaps.size() == m_wakeHeaps.capacity();
+		m_allocationCount += m_finishHeaps.size() == m_finishHeaps.capacity();
+#endif
+		unused = static_cast<unsigned int>(m_groupRefs.size());
+		m_groupRefs.push_back(GroupRef());
+		m_wakeHeaps.push_back(TweenVector<TweenWake, Alloc>(m_allocator));
+		m_finishHeaps.push_back(TweenVector<TweenWake, Alloc>(m_allocator));
+	}
+
+	// An unused entry only has stale timers left, its clock starts over
+	m_groupRefs[unused].group = group;
+	m_groupRefs[unused].users = 1;
+	m_groupRefs[unused].time = 0;
+	m_wakeHeaps[unused].clear();
+	m_finishHeaps[unused].clear();
+	return unused;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::ReleaseGroup(unsigned int group)
+{
+	// The group may be destroyed once no tween uses it anymore
+	if (group && --m_groupRefs[group].users == 0)
+	{
+		m_groupRefs[group].group = nullptr;
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::FreeSlot(unsigned int slot)
+{
+	TweenSlot& entry = m_slots[slot];
+	if (++entry.generation == 0)
+	{
+		entry.generation = 1;
+	}
+	entry.index = m_freeSlot;
+	m_freeSlot = slot;
+
+	if (slot < m_slotWaiters.size() && m_slotWaiters[slot])
+	{
+		ExpireWaiters(slot);
+	}
+}
+
+template<class T, class Alloc> bool STween<T, Alloc>::LinkWaiter(void* manager, TweenHandle handle, TweenWaitNode& node)
+{
+	STween& tweens = *static_cast<STween*>(manager);
+	if (!tweens.IsAlive(handle))
+	{
+		return false;
+	}
+
+	if (handle.index >= tweens.m_slotWaiters.size())
+	{
+#ifdef STWEEN_TRACK_ALLOCATIONS
+		tweens.m_allocationCount += tweens.m_slots.size() > tweens.m_slotWaiters.capacity();
+#endif
+		tweens.m_slotWaiters.resize(tweens.m_slots.size(), nullptr);
+	}
+	node.next = tweens.m_slotWaiters[handle.index];
+	tweens.m_slotWaiters[handle.index] = &node;
+	return true;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::ExpireWaiters(unsigned int slot)
+{
+	TweenWaitNode* node = m_slotWaiters[slot];
+	m_slotWaiters[slot] = nullptr;
+	for (; node; node = node->next)
+	{
+		TweenWaiter* waiter = node->waiter;
+		if (--waiter->pending == 0)
+		{
+			waiter->nextReady = nullptr;
+			if (m_lastReadyWaiter)
+				m_lastReadyWaiter->nextReady = waiter;
+			else
+				m_readyWaiters = waiter;
+			m_lastReadyWaiter = waiter;
+		}
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::ResumeWaiters()
+{
+	STWEEN_ZONE("STween::Resume");
+	// Waiters queued by the coroutines resumed here are left for the next Update()
+	TweenWaiter* waiter = m_readyWaiters;
+	m_readyWaiters = nullptr;
+	m_lastReadyWaiter = nullptr;
+	while (waiter)
+	{
+		// The waiter is gone once its coroutine carries on
+		TweenWaiter* next = waiter->nextReady;
+		waiter->resume(waiter);
+		waiter = next;
+	}
+}
+
+template<class T, class Alloc> unsigned int STween<T, Alloc>::IndexOf(TweenHandle handle) const
+{
+	if (handle.index >= m_slots.size())
+	{
+		return NoIndex;
+	}
+
+	const TweenSlot& entry = m_slots[handle.index];
+	if (entry.generation != handle.generation || entry.index >= m_slotOf.size()
+		|| m_slotOf[entry.index] != handle.index)
+	{
+		return NoIndex;
+	}
+
+	return entry.index;
+}
+
+template<class T, class Alloc> unsigned int STween<T, Alloc>::ParkedIndexOf(TweenHandle handle) const
+{
+	if (!m_parked || handle.index >= m_slots.size())
+	{
+		return NoIndex;
+	}
+
+	const TweenSlot& entry = m_slots[handle.index];
+	const unsigned int index = entry.index & ~ParkedBit;
+	if (entry.generation != handle.generation || !(entry.index & ParkedBit)
+		|| index >= m_parked->m_slotOf.size() || m_parked->m_slotOf[index] != handle.index)
+	{
+		return NoIndex;
+	}
+
+	return index;
+}
+
+template<class T, class Alloc> STween<T, Alloc>* STween<T, Alloc>::Locate(TweenHandle handle, unsigned int& index)
+{
+	index = IndexOf(handle);
+	if (index != NoIndex)
+	{
+		return this;
+	}
+
+	index = ParkedIndexOf(handle);
+	return index != NoIndex ? m_parked.get() : nullptr;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::ParkDelayed()
+{
+	m_hasPendingDelays = false;
+	if (!m_parked)
+	{
+		m_parked = std::allocate_shared<STween>(m_allocator, m_allocator);
+	}
+
+	size_t kept = 0;
+	size_t pulled = m_pulledCount;
+	for (size_t i = 0; i < m_flags.size(); ++i)
+	{
+		// Killed tweens are left for Update() to drop
+		if ((m_flags[i] & (FlagReady | FlagDelayed)) == (FlagReady | FlagDelayed))
+		{
+			pulled -= i < m_pulledCount;
+			const unsigned int slot = m_slotOf[i];
+			const float delay = ColdOf(i).delay;
+#ifdef STWEEN_TRACK_ALLOCATIONS
+			m_allocationCount += m_parkedWake.size() == m_parkedWake.capacity();
+#endif
+			if (m_flags[i] & FlagPaused)
+			{
+				m_parkedWake.push_back(delay);
+			}
+			else
+			{
+				m_parkedWake.push_back(m_groupRefs[m_group[i]].time + delay);
+				PushTimer(m_wakeHeaps[m_group[i]], slot, m_parkedWake.back());
+			}
+
+			Detail::ColumnPushFrom push = { i };
+			m_parked->ForEachColumnPair(*this, push);
+			m_parked->AdoptCold(*this, i, m_parked->m_flags.size() - 1);
+			m_slots[slot].index = ParkedBit | static_cast<unsigned int>(m_parked->m_flags.size() - 1);
+			continue;
+		}
+
+		if (kept != i)
+		{
+			MoveTween(i, kept);
+		}
+		++kept;
+	}
+
+	TruncateTweens(kept);
+	m_pulledCount = pulled;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::PushTimer(TweenVector<TweenWake, Alloc>& heap, unsigned int slot, double time)
+{
+	const TweenWake wake = { time, slot, m_slots[slot].generation };
+#ifdef STWEEN_TRACK_ALLOCATIONS
+	m_allocationCount += heap.size() == heap.capacity();
+#endif
+	heap.push_back(wake);
+	std::push_heap(heap.begin(), heap.end(), WakesLater());
+}
+
+template<class T, class Alloc>bool STween<T, Alloc>::HasDueWakes() const
+{
+	for (size_t k = 0; k < m_wakeHeaps.size(); ++k)
+	{
+		if (!m_wakeHeaps[k].empty() && m_wakeHeaps[k].front().time <= m_groupRefs[k].time)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::WakeDelayed()
+{
+	for (size_t k = 0; k < m_wakeHeaps.size(); ++k)
+	{
+		TweenVector<TweenWake, Alloc>& heap = m_wakeHeaps[k];
+		const double now = m_groupRefs[k].time;
+		while (!heap.empty() && heap.front().time <= now)
+		{
+			const TweenWake wake = heap.front();
+			std::pop_heap(heap.begin(), heap.end(), WakesLater());
+			heap.pop_back();
+
+			// Killed, paused or resumed while waiting, the current entry of a resumed tween is the one with its wake time
+			const TweenSlot& entry = m_slots[wake.slot];
+			const size_t parked = entry.index & ~ParkedBit;
+			if (entry.generation != wake.generation || !(entry.index & ParkedBit)
+				|| (m_parked->m_flags[parked] & FlagPaused) || m_parkedWake[parked] != wake.time)
+			{
+				continue;
+			}
+
+#ifdef STWEEN_TRACK_ALLOCATIONS
+			Detail::ColumnGrowth growth = { 0 };
+			ForEachColumn(growth);
+			m_allocationCount += growth.count;
+#endif
+			const size_t index = m_flags.size();
+			Detail::ColumnPushFrom push = { parked };
+			ForEachColumnPair(*m_parked, push);
+			AdoptCold(*m_parked, parked, index);
+			RemoveParked(parked);
+
+			// Starts as if it had been created when the wait ended, the group time since then already has its scale
+			m_slots[wake.slot].index = static_cast<unsigned int>(index);
+			m_flags[index] &= ~FlagDelayed;
+			m_progress[index] += static_cast<float>(now - wake.time) * m_invDuration[index];
+			AnchorTicks(index);
+			m_hasUnsortedTargets = true;
+		}
+	}
+
+	m_lastTweenIndex = static_cast<int>(m_flags.size()) - 1;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::UnparkAll()
+{
+	// Parked tweens are removed as soon as they are killed, paused ones have no heap entry
+	const size_t parked = m_parked ? m_parked->m_flags.size() : 0;
+	for (size_t k = 0; k < parked; ++k)
+	{
+		const size_t index = m_flags.size();
+		const float delay = DelayOf(*m_parked, k);
+		Detail::ColumnPushFrom push = { k };
+		ForEachColumnPair(*m_parked, push);
+		AdoptCold(*m_parked, k, index);
+
+		m_slots[m_slotOf[index]].index = static_cast<unsigned int>(index);
+		OwnCold(index).delay = delay;
+		m_hasPendingDelays = true;
+		m_hasUnsortedTargets = true;
+	}
+
+	for (size_t k = 0; k < m_wakeHeaps.size(); ++k)
+	{
+		m_wakeHeaps[k].clear();
+	}
+	m_parkedWake.clear();
+	if (m_parked)
+	{
+		m_parked->TruncateTweens(0);
+	}
+	m_lastTweenIndex = static_cast<int>(m_flags.size()) - 1;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::RemoveParked(size_t index)
+{
+	STween& parked = *m_parked;
+	const size_t last = parked.m_flags.size() - 1;
+	parked.FreeCold(index);
+	if (index != last)
+	{
+		Detail::ColumnMove move = { last, index };
+		parked.ForEachColumn(move);
+		parked.m_coldOf[last] = 0;
+		m_parkedWake[index] = m_parkedWake[last];
+		m_slots[parked.m_slotOf[index]].index = ParkedBit | static_cast<unsigned int>(index);
+	}
+
+	parked.TruncateTweens(last);
+	m_parkedWake.pop_back();
+
+	// Only stale entries are left, dropped so killing waiting tweens doesn't grow the heaps
+	if (!last)
+	{
+		for (size_t k = 0; k < m_wakeHeaps.size(); ++k)
+		{
+			m_wakeHeaps[k].clear();
+		}
+	}
+}
+
+template<class T, class Alloc> float STween<T, Alloc>::DelayOf(const STween& storage, size_t index) const
+{
+	if (&storage == this)
+	{
+		return (m_flags[index] & FlagDelayed) ? ColdOf(index).delay : 0.0f;
+	}
+
+	// Parked tweens are removed as soon as they are killed, so their entry is always current
+	if (m_parked->m_flags[index] & FlagPaused)
+	{
+		return static_cast<float>(m_parkedWake[index]);
+	}
+	return static_cast<float>(m_parkedWake[index] - m_groupRefs[m_parked->m_group[index]].time);
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::TruncateTweens(size_t count)
+{
+	for (size_t i = count; i < m_coldOf.size(); ++i)
+	{
+		FreeCold(i);
+	}
+	Detail::ColumnTruncate truncate = { count };
+	ForEachColumn(truncate);
+
+	m_pulledCount = std::min(m_pulledCount, count);
+	m_lastTweenIndex = static_cast<int>(count) - 1;
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::From(T* initVal)
+{
+	PushTween(initVal, *initVal);
+
+	return *this;
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::From(T initVal)
+{
+	PushTween(nullptr, initVal);
+
+	return *this;
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::To(T finalVal)
+{
+	m_end[m_lastTweenIndex] = finalVal;
+	ResolveValues(m_lastTweenIndex);
+
+	return *this;
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::Time(float sec)
+{
+	SetTiming(m_lastTweenIndex, sec, 0);
+
+	return *this;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::Update(float deltaTime)
+{
+	if (!Clock().tickRate)
+	{
+		Advance(deltaTime, 0);
+		return;
+	}
+
+	const unsigned int ticks = Clock().AddTime(deltaTime);
+	if (ticks)
+	{
+		StepTicks(ticks);
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::SetTickRate(unsigned int ticksPerSecond)
+{
+	// Running tweens and the clock move to the closest tick, delayed ones when they wake
+	Clock().SetTickRate(ticksPerSecond);
+	AnchorAllTicks();
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::AnchorAllTicks()
+{
+	if (!Clock().tickRate)
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < m_flags.size(); ++i)
+	{
+		AnchorTicks(i);
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::StepTicks(unsigned int ticks)
+{
+	const Detail::TweenClock& clock = Clock();
+	if (clock.tickRate)
+	{
+		Advance(static_cast<float>(ticks * clock.tickSeconds), ticks);
+	}
+}
+
+template<class T, class Alloc> Detail::TweenClock& STween<T, Alloc>::Clock()
+{
+	return m_sharedClock ? *m_sharedClock : m_ownClock;
+}
+
+template<class T, class Alloc> const Detail::TweenClock& STween<T, Alloc>::Clock() const
+{
+	return m_sharedClock ? *m_sharedClock : m_ownClock;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::Advance(float deltaTime, unsigned int ticks)
+{
+	STWEEN_ZONE("STween::Update");
+	ScheduleTweens();
+	EvaluateTweens(deltaTime, ticks);
+	Clock().Advance(deltaTime, ticks);
+	FinishTweens();
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::ScheduleTweens()
+{
+	if (m_submitQueue && !m_submitQueue->Empty())
+	{
+		DrainSubmitted();
+	}
+#ifdef STWEEN_TRACK_ALLOCATIONS
+	m_allocationsBefore = m_allocationCount;
+#endif
+#ifdef STWEEN_STATS
+	m_stats = TweenStats();
+	m_stats.active = m_flags.size();
+	const double wakeBegin = Detail::StatsNow();
+#endif
+
+	// Tweens killed since the last Update(), before delayed ones move the others
+	if (m_pullMode && !m_pulledDead.empty())
+	{
+		ReclaimPulled();
+	}
+
+	// Delayed tweens leave the arrays until their wait is over,
+	// only the top of the timer heap of each group is checked each frame
+	const bool waiting = m_parked && !m_parked->m_flags.empty();
+	if (m_hasPendingDelays || (waiting && HasDueWakes()))
+	{
+		STWEEN_ZONE("STween::Wake");
+		if (m_hasPendingDelays)
+		{
+			ParkDelayed();
+		}
+		if (HasDueWakes())
+		{
+			WakeDelayed();
+		}
+	}
+	if (m_pullMode)
+	{
+		if (m_pulledCount < m_flags.size())
+			StartAddedPulled();
+	}
+	else if (m_sortedTargets && m_hasUnsortedTargets)
+	{
+		STWEEN_ZONE("STween::Sort");
+		SortTargets();
+	}
+#ifdef STWEEN_STATS
+	m_stats.wakeSeconds = Detail::StatsNow() - wakeBegin;
+#endif
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::EvaluateTweens(float deltaTime, unsigned int ticks)
+{
+	m_updatedCount = 0;
+	m_finishedCount = 0;
+	// Nothing running nor waiting
+	const bool waiting = m_parked && !m_parked->m_flags.empty();
+	if (m_flags.empty() && !waiting)
+	{
+		return;
+	}
+
+	// Tweens advance by the deltaTime of their group
+	ResizeScratch(m_groupDelta, m_groupRefs.size());
+	m_groupDelta[0] = deltaTime;
+	for (size_t k = 1; k < m_groupRefs.size(); ++k)
+	{
+		const TweenGroup* group = m_groupRefs[k].group;
+		m_groupDelta[k] = group ? deltaTime * group->GetEffectiveScale() : 0.0f;
+	}
+	if (m_flags.empty())
+	{
+		AdvanceGroups(ticks);
+		return;
+	}
+
+	STWEEN_ZONE("STween::Evaluate");
+#ifdef STWEEN_STATS
+	const double evaluateBegin = Detail::StatsNow();
+#endif
+	// Only the tweens whose time has come are visited, values are computed by Sample()
+	if (m_pullMode)
+	{
+		FinishPulled();
+		AdvanceGroups(ticks);
+#ifdef STWEEN_STATS
+		m_stats.evaluateSeconds = Detail::StatsNow() - evaluateBegin - m_stats.callbackSeconds;
+#endif
+		return;
+	}
+
+	// Tweens finished or killed during the loop are dropped by FinishTweens(),
+	// so indices hold while callbacks run.
+	// Chained tweens are appended at the back while iterating
+	// and are moved down with the others.
+	const size_t count = m_flags.size();
+	if (m_batchedEasing)
+	{
+		EaseBatched(count);
+	}
+
+	// Values are computed and written by the job system first,
+	// then callbacks and chains run below in order on this thread
+	const bool parallel = m_jobSystem && count > m_parallelGrain;
+	if (parallel)
+	{
+		ResizeScratch(m_values, count);
+		m_jobSystem->ParallelFor(count, m_parallelGrain, &STween::EvaluateJob, this);
+	}
+
+	const bool separateWrites = m_separateWrites;
+	if (separateWrites)
+	{
+		ResizeScratch(m_writeTargets, count);
+		ResizeScratch(m_writeValues, count);
+	}
+	m_writeCount = 0;
+
+	// Modes are resolved once per Update(), each has its own loop
+	if (m_deferredCallbacks)
+		UpdateDeferred(count, parallel, ticks);
+	else if (parallel && separateWrites)
+		UpdateImmediate<true, true>(count, ticks);
+	else if (parallel)
+		UpdateImmediate<true, false>(count, ticks);
+	else if (separateWrites)
+		UpdateImmediate<false, true>(count, ticks);
+	else
+		UpdateImmediate<false, false>(count, ticks);
+
+	// Scatter pass of SetSeparateWrites(), in storage order
+	for (size_t k = 0; k < m_writeCount; ++k)
+	{
+		*m_writeTargets[k] = m_writeValues[k];
+	}
+	AdvanceGroups(ticks);
+#ifdef STWEEN_STATS
+	m_stats.evaluateSeconds = Detail::StatsNow() - evaluateBegin - m_stats.callbackSeconds;
+#endif
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::AdvanceGroups(unsigned int ticks)
+{
+	// Scales are ignored in tick mode, pausing still applies
+	// Groups first used by callbacks of this Update() start on the next one
+	const Detail::TweenClock& clock = Clock();
+	for (size_t k = 0; k < m_groupDelta.size(); ++k)
+	{
+		if (clock.tickRate)
+			m_groupRefs[k].time += m_groupDelta[k] != 0 ? ticks * clock.tickSeconds : 0.0;
+		else
+			m_groupRefs[k].time += m_groupDelta[k];
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::FinishTweens()
+{
+	if (m_pullMode ? !m_pulledDead.empty() : !m_flags.empty())
+	{
+		STWEEN_ZONE("STween::Compact");
+#ifdef STWEEN_STATS
+		const double compactBegin = Detail::StatsNow();
+#endif
+		if (m_pullMode)
+			ReclaimPulled();
+		else
+			CompactTweens();
+#ifdef STWEEN_STATS
+		m_stats.compactSeconds = Detail::StatsNow() - compactBegin;
+#endif
+	}
+	if (m_readyWaiters)
+	{
+		ResumeWaiters();
+	}
+#ifdef STWEEN_STATS
+	m_stats.totalSeconds = m_stats.wakeSeconds + m_stats.evaluateSeconds + m_stats.callbackSeconds + m_stats.compactSeconds;
+	m_stats.parked = m_parked ? m_parked->m_flags.size() : 0;
+#endif
+
+#ifdef STWEEN_TRACK_ALLOCATIONS
+	m_updateAllocations = m_allocationCount - m_allocationsBefore;
+#ifdef STWEEN_ASSERT_NO_UPDATE_ALLOCATIONS
+	assert(m_updateAllocations == 0 && "STween::Update() allocated memory");
+#endif
+#endif
+}
+
+template<class T, class Alloc>T STween<T, Alloc>::Evaluate(size_t index) const
+{
+	float eased;
+	if (m_batchedEasing)
+		eased = m_eased[index];
+	else if (m_sampledEasing)
+		eased = m_sampledEasing->Evaluate(m_easing[index], m_progress[index]);
+	else
+		eased = Detail::Ease(m_easing[index], m_progress[index]);
+
+	return Detail::Lanes<T>::Evaluate(m_base[index], m_delta[index], eased);
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::EvaluateJob(void* context, size_t begin, size_t end)
+{
+	STween& tweens = *static_cast<STween*>(context);
+	for (size_t i = begin; i < end; ++i)
+	{
+		if ((tweens.m_flags[i] & (FlagReady | FlagPaused)) == FlagReady)
+		{
+			const T value = tweens.Evaluate(i);
+			tweens.m_values[i] = value;
+
+			T* target = tweens.TargetOf(i);
+			if (target && !tweens.m_separateWrites)
+			{
+				*target = value;
+			}
+		}
+	}
+}
+
+template<class T, class Alloc> template<bool Parallel, bool SeparateWrites> T STween<T, Alloc>::WriteValue(size_t index, T* target, float progress)
+{
+	const T value = Parallel ? m_values[index] : Evaluate(index);
+	if (target && SeparateWrites)
+	{
+		// Finished tweens get their final value instead
+		if (progress < 1.0f)
+		{
+			m_writeTargets[m_writeCount] = target;
+			m_writeValues[m_writeCount] = value;
+			++m_writeCount;
+		}
+	}
+	else if (target && !Parallel)
+	{
+		*target = value;
+	}
+#ifdef STWEEN_STATS
+	++m_stats.evaluated;
+#endif
+
+	return value;
+}
+
+template<class T, class Alloc> template<bool Parallel, bool SeparateWrites> void STween<T, Alloc>::UpdateImmediate(size_t count, unsigned int ticks)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		const unsigned char flags = m_flags[i];
+		const float progress = m_progress[i];
+
+		// Running without step callback nor reaching its end, no user code runs
+		if ((flags & (FlagReady | FlagPaused | FlagStepCallback)) == FlagReady && progress < 1.0f)
+		{
+			WriteValue<Parallel, SeparateWrites>(i, TargetOf(i), progress);
+			StepTween(i, flags, progress, ticks);
+			continue;
+		}
+
+		UpdateTween<Parallel, SeparateWrites>(i, flags, progress, ticks);
+	}
+}
+
+template<class T, class Alloc> template<bool Parallel, bool SeparateWrites> void STween<T, Alloc>::UpdateTween(size_t index, unsigned char flags, float progress, unsigned int ticks)
+{
+	// Killed tweens are dropped by CompactTweens(), paused ones wait
+	if ((flags & (FlagReady | FlagPaused)) != FlagReady)
+	{
+		return;
+	}
+
+	T* target = TargetOf(index);
+	T value = WriteValue<Parallel, SeparateWrites>(index, target, progress);
+	if (flags & FlagStepCallback)
+	{
+#ifdef STWEEN_STATS
+		const double stepBegin = Detail::StatsNow();
+		++m_stats.stepCallbacks;
+#endif
+		RunStepCallback(index, value);
+#ifdef STWEEN_STATS
+		m_stats.callbackSeconds += Detail::StatsNow() - stepBegin;
+#endif
+	}
+
+	if (progress < 1.0f)
+	{
+		StepTween(index, flags, progress, ticks);
+		return;
+	}
+
+	FinishTween(index, flags, target);
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::FinishTween(size_t index, unsigned char flags, T* target)
+{
+	if (target)
+	{
+		*target = (flags & FlagReversed) ? m_start[index] : m_end[index];
+	}
+
+	m_flags[index] &= ~FlagReady;
+	ReleaseSlot(index);
+#ifdef STWEEN_STATS
+	++m_stats.finished;
+#endif
+
+	if (flags & (FlagFinishCallback | FlagChain))
+	{
+		STWEEN_ZONE("STween::Callbacks");
+#ifdef STWEEN_STATS
+		const double finishBegin = Detail::StatsNow();
+#endif
+		if (flags & FlagFinishCallback)
+		{
+			RunFinishCallback(index);
+		}
+
+		if (flags & FlagChain)
+		{
+			// Copied on purpose: starting the sequence may grow m_coldPool
+			const std::shared_ptr<const TweenSequence<T, Alloc>> chain = CallbacksOf(index).endTween;
+			StartSequence(chain);
+#ifdef STWEEN_STATS
+			++m_stats.chained;
+#endif
+		}
+#ifdef STWEEN_STATS
+		m_stats.callbackSeconds += Detail::StatsNow() - finishBegin;
+#endif
+	}
+	// While it is still in cache, CompactTweens() then has nothing to free
+	FreeCold(index);
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::CompactTweens()
+{
+	size_t alive = 0;
+	for (size_t i = 0; i < m_flags.size(); ++i)
+	{
+		if (!(m_flags[i] & FlagReady))
+		{
+			ReleaseGroup(m_group[i]);
+			ReleaseSlot(i);
+			FreeCold(i);
+			continue;
+		}
+
+		if (alive != i)
+		{
+			MoveTween(i, alive);
+		}
+		++alive;
+	}
+
+	TruncateTweens(alive);
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::UpdateDeferred(size_t count, bool parallel, unsigned int ticks)
+{
+	ResizeScratch(m_updatedHandles, count);
+	ResizeScratch(m_updatedValues, count);
+	ResizeScratch(m_updatedIndex, count);
+	ResizeScratch(m_finishedHandles, count);
+	ResizeScratch(m_finishedIndex, count);
+
+	// Values, targets and progress only, no user code runs here
+	for (size_t i = 0; i < count; ++i)
+	{
+		const unsigned char flags = m_flags[i];
+		if ((flags & (FlagReady | FlagPaused)) != FlagReady)
+		{
+			continue;
+		}
+
+		const float progress = m_progress[i];
+		const bool finished = progress >= 1.0f;
+		T* target = TargetOf(i);
+		if (!m_pullMode)
+		{
+			T value = finished ? ((flags & FlagReversed) ? m_start[i] : m_end[i]) : (parallel ? m_values[i] : Evaluate(i));
+			if (target && !finished && m_separateWrites)
+			{
+				m_writeTargets[m_writeCount] = target;
+				m_writeValues[m_writeCount] = value;
+				++m_writeCount;
+			}
+			else if (target && (finished || !parallel))
+			{
+				*target = value;
+			}
+
+			m_updatedHandles[m_updatedCount] = HandleOf(i);
+			m_updatedValues[m_updatedCount] = value;
+			m_updatedIndex[m_updatedCount] = static_cast<unsigned int>(i);
+			++m_updatedCount;
+		}
+		else if (finished && target)
+		{
+			*target = (flags & FlagReversed) ? m_start[i] : m_end[i];
+		}
+
+		if (finished)
+		{
+			m_finishedHandles[m_finishedCount] = HandleOf(i);
+			m_finishedIndex[m_finishedCount] = static_cast<unsigned int>(i);
+			++m_finishedCount;
+		}
+		else
+		{
+			StepTween(i, flags, progress, ticks);
+		}
+	}
+#ifdef STWEEN_STATS
+	m_stats.evaluated = m_updatedCount;
+#endif
+
+	// User code, tweens have not moved yet so the recorded indices still hold
+	// Chained tweens are appended at the back and left for CompactTweens()
+	{
+		STWEEN_ZONE("STween::Callbacks");
+#ifdef STWEEN_STATS
+		const double callbackBegin = Detail::StatsNow();
+#endif
+		if (m_batchHandler && m_updatedCount)
+		{
+			m_batchHandler->OnStep(TweenSpan<const TweenHandle>(m_updatedHandles.data(), m_updatedCount), TweenSpan<const T>(m_updatedValues.data(), m_updatedCount));
+		}
+		for (size_t k = 0; k < m_updatedCount; ++k)
+		{
+			const unsigned int i = m_updatedIndex[k];
+			// Skips tweens killed by earlier callbacks
+			if ((m_flags[i] & (FlagReady | FlagStepCallback)) == (FlagReady | FlagStepCallback))
+			{
+#ifdef STWEEN_STATS
+				++m_stats.stepCallbacks;
+#endif
+				T value = m_updatedValues[k];
+				RunStepCallback(i, value);
+			}
+		}
+
+		// Finished tweens expire before their finish callbacks run, as in the immediate loop
+		size_t finishedCount = 0;
+		for (size_t k = 0; k < m_finishedCount; ++k)
+		{
+			const unsigned int i = m_finishedIndex[k];
+			if (m_flags[i] & FlagReady)
+			{
+				m_flags[i] &= ~FlagReady;
+				ReleaseSlot(i);
+				m_finishedHandles[finishedCount] = m_finishedHandles[k];
+				m_finishedIndex[finishedCount] = i;
+				++finishedCount;
+			}
+		}
+		m_finishedCount = finishedCount;
+#ifdef STWEEN_STATS
+		m_stats.finished = m_finishedCount;
+#endif
+
+		if (m_batchHandler && m_finishedCount)
+		{
+			m_batchHandler->OnFinish(TweenSpan<const TweenHandle>(m_finishedHandles.data(), m_finishedCount));
+		}
+		for (size_t k = 0; k < m_finishedCount; ++k)
+		{
+			const unsigned int i = m_finishedIndex[k];
+			const unsigned char flags = m_flags[i];
+			if (flags & FlagFinishCallback)
+			{
+				RunFinishCallback(i);
+			}
+
+			if (flags & FlagChain)
+			{
+				// Copied on purpose: starting the sequence may grow m_coldPool
+				const std::shared_ptr<const TweenSequence<T, Alloc>> chain = CallbacksOf(i).endTween;
+				StartSequence(chain);
+#ifdef STWEEN_STATS
+				++m_stats.chained;
+#endif
+			}
+		}
+#ifdef STWEEN_STATS
+		m_stats.callbackSeconds = Detail::StatsNow() - callbackBegin;
+#endif
+	}
+}
+
+template<class T, class Alloc>TweenHandle STween<T, Alloc>::HandleOf(size_t index) const
+{
+	const unsigned int slot = m_slotOf[index];
+	return slot != NoIndex ? TweenHandle(slot, m_slots[slot].generation) : TweenHandle();
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::SetDeferredCallbacks(bool enabled, TweenBatchHandler<T>* handler)
+{
+	m_deferredCallbacks = enabled;
+	m_batchHandler = enabled ? handler : nullptr;
+}
+
+template<class T, class Alloc>TweenSpan<const TweenHandle> STween<T, Alloc>::GetUpdatedHandles() const
+{
+	return TweenSpan<const TweenHandle>(m_updatedHandles.data(), m_updatedCount);
+}
+
+template<class T, class Alloc>TweenSpan<const T> STween<T, Alloc>::GetUpdatedValues() const
+{
+	return TweenSpan<const T>(m_updatedValues.data(), m_updatedCount);
+}
+
+template<class T, class Alloc>TweenSpan<const TweenHandle> STween<T, Alloc>::GetFinishedHandles() const
+{
+	return TweenSpan<const TweenHandle>(m_finishedHandles.data(), m_finishedCount);
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::SetJobSystem(TweenJobSystem* jobSystem, size_t grain)
+{
+	m_jobSystem = jobSystem;
+	m_parallelGrain = grain > 0 ? grain : 1;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::SetSubmitQueue(TweenSubmitQueue<T, Alloc>* queue)
+{
+	m_submitQueue = queue;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::DrainSubmitted()
+{
+	m_submitQueue->Drain([this](TweenData<T>&& tween) { AddTweenData(std::move(tween)); });
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::EaseBatched(size_t count)
+{
+	ResizeScratch(m_easeOrder, count);
+	ResizeScratch(m_easeBuffer, count);
+	ResizeScratch(m_eased, count);
+
+	// One bucket per built-in and custom easing function
+	const size_t easingCount = Detail::EasingCount();
+	ResizeScratch(m_bucketStart, easingCount + 1);
+	ResizeScratch(m_bucketFill, easingCount);
+	size_t* bucketStart = m_bucketStart.data();
+	size_t* bucketFill = m_bucketFill.data();
+
+	// Counting sort of the running tweens by easing function
+	std::fill(bucketStart, bucketStart + easingCount + 1, 0);
+	for (size_t i = 0; i < count; ++i)
+	{
+		if ((m_flags[i] & (FlagReady | FlagPaused)) == FlagReady)
+		{
+			const size_t easing = static_cast<unsigned int>(m_easing[i]);
+			bucketStart[(easing < easingCount ? easing : 0) + 1]++;
+		}
+	}
+
+	for (size_t e = 0; e < easingCount; ++e)
+	{
+		bucketStart[e + 1] += bucketStart[e];
+		bucketFill[e] = bucketStart[e];
+	}
+
+	// Gather the positions of each bucket contiguously
+	for (size_t i = 0; i < count; ++i)
+	{
+		if ((m_flags[i] & (FlagReady | FlagPaused)) == FlagReady)
+		{
+			const size_t easing = static_cast<unsigned int>(m_easing[i]);
+			const size_t slot = bucketFill[easing < easingCount ? easing : 0]++;
+			m_easeOrder[slot] = static_cast<unsigned int>(i);
+			m_easeBuffer[slot] = m_progress[i];
+		}
+	}
+
+	for (size_t e = 0; e < easingCount; ++e)
+	{
+		const size_t first = bucketStart[e];
+		if (m_sampledEasing)
+			m_sampledEasing->EvaluateRange(static_cast<EasingFunction>(e), m_easeBuffer.data() + first, bucketStart[e + 1] - first);
+		else
+			Detail::EaseBatch(static_cast<EasingFunction>(e), m_easeBuffer.data() + first, bucketStart[e + 1] - first);
+	}
+
+	// Scatter the results back to tween order
+	const size_t active = bucketStart[easingCount];
+	for (size_t slot = 0; slot < active; ++slot)
+	{
+		m_eased[m_easeOrder[slot]] = m_easeBuffer[slot];
+	}
+}
+
+template<class T, class Alloc> template<class Buffer> void STween<T, Alloc>::ResizeScratch(Buffer& buffer, size_t size)
+{
+#ifdef STWEEN_TRACK_ALLOCATIONS
+	m_allocationCount += size > buffer.capacity();
+#endif
+	buffer.resize(size);
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::SetBatchedEasing(bool enabled)
+{
+	m_batchedEasing = enabled;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::SetSampledEasing(const SampledEasing* sampledEasing)
+{
+	m_sampledEasing = sampledEasing;
+}
+
+#ifdef STWEEN_TRACK_ALLOCATIONS
+template<class T, class Alloc>size_t STween<T, Alloc>::GetUpdateAllocations() const
+{
+	return m_updateAllocations;
+}
+#endif
+
+#ifdef STWEEN_STATS
+template<class T, class Alloc>const TweenStats& STween<T, Alloc>::GetStats() const
+{
+	return m_stats;
+}
+#endif
+
+template<class T, class Alloc>const typename STween<T, Alloc>::TweenCold& STween<T, Alloc>::ColdOf(size_t index) const
+{
+	static const TweenCold none;
+	const unsigned int entry = m_coldOf[index];
+	return entry ? m_coldPool[entry - 1] : none;
+}
+
+template<class T, class Alloc>typename STween<T, Alloc>::TweenCold& STween<T, Alloc>::OwnCold(size_t index)
+{
+	unsigned int& entry = m_coldOf[index];
+	if (!entry)
+	{
+		if (!m_freeCold.empty())
+		{
+			entry = m_freeCold.back() + 1;
+			m_freeCold.pop_back();
+		}
+		else
+		{
+#ifdef STWEEN_TRACK_ALLOCATIONS
+			m_allocationCount += m_coldPool.size() == m_coldPool.capacity();
+#endif
+			m_coldPool.emplace_back();
+			entry = static_cast<unsigned int>(m_coldPool.size());
+			// Room for every entry to be freed, so freeing never allocates
+			if (m_freeCold.capacity() < m_coldPool.capacity())
+			{
+				m_freeCold.reserve(m_coldPool.capacity());
+			}
+		}
+	}
+
+	return m_coldPool[entry - 1];
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::FreeCold(size_t index)
+{
+	const unsigned int entry = m_coldOf[index];
+	if (!entry)
+	{
+		return;
+	}
+
+	// Callbacks and borrowed sequences are released now, not when the entry is reused
+	TweenCold& cold = m_coldPool[entry - 1];
+	cold.callbacks.finishCallback.Reset();
+	cold.callbacks.stepCallback.Reset();
+	if (cold.callbacks.endTween)
+		cold.callbacks.endTween.reset();
+	if (cold.source)
+		cold.source.reset();
+	cold.sourceIndex = 0;
+	cold.delay = 0;
+	cold.loops = 0;
+	cold.owner = 0;
+	m_freeCold.push_back(entry - 1);
+	m_coldOf[index] = 0;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::AdoptCold(STween& source, size_t sourceIndex, size_t index)
+{
+	// m_coldOf[index] still holds the entry in the pool of 'source'
+	const unsigned int entry = m_coldOf[index];
+	if (!entry)
+	{
+		return;
+	}
+
+	m_coldOf[index] = 0;
+	OwnCold(index) = std::move(source.m_coldPool[entry - 1]);
+	source.FreeCold(sourceIndex);
+}
+
+template<class T, class Alloc>const TweenCallbacks<T, Alloc>& STween<T, Alloc>::CallbacksOf(size_t index) const
+{
+	const TweenCold& cold = ColdOf(index);
+	return cold.source ? cold.source->callbacks[cold.sourceIndex] : cold.callbacks;
+}
+
+template<class T, class Alloc>TweenCallbacks<T, Alloc>& STween<T, Alloc>::OwnCallbacks(size_t index)
+{
+	TweenCold& cold = OwnCold(index);
+	if (cold.source)
+	{
+		cold.callbacks = cold.source->callbacks[cold.sourceIndex];
+		cold.source.reset();
+	}
+
+	return cold.callbacks;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::RunStepCallback(size_t index, T& value)
+{
+	// Tweens with callbacks always have a pool entry, it stays theirs while the callback runs
+	const unsigned int entry = m_coldOf[index] - 1;
+	TweenCold& cold = m_coldPool[entry];
+	if (cold.source)
+	{
+		// Sequences never change, holding one keeps its callbacks in place
+		const std::shared_ptr<const TweenSequence<T, Alloc>> source = cold.source;
+		source->callbacks[cold.sourceIndex].stepCallback(value);
+		return;
+	}
+
+	TweenFunction<void(T&)> callback(std::move(cold.callbacks.stepCallback));
+	callback(value);
+	// Put back unless the callback replaced it
+	TweenCold& after = m_coldPool[entry];
+	if (!after.source && !after.callbacks.stepCallback)
+	{
+		after.callbacks.stepCallback = std::move(callback);
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::RunFinishCallback(size_t index)
+{
+	TweenCold& cold = m_coldPool[m_coldOf[index] - 1];
+	if (cold.source)
+	{
+		const std::shared_ptr<const TweenSequence<T, Alloc>> source = cold.source;
+		source->callbacks[cold.sourceIndex].finishCallback();
+		return;
+	}
+
+	// Finished tweens never call it again
+	const TweenFunction<void()> callback(std::move(cold.callbacks.finishCallback));
+	callback();
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::StartSequence(const std::shared_ptr<const TweenSequence<T, Alloc>>& sequence)
+{
+	const TweenSequence<T, Alloc>& tweens = *sequence;
+	for (size_t k = 0; k < tweens.flags.size(); ++k)
+	{
+		PushTween(tweens.target[k], tweens.start[k]);
+
+		m_end[m_lastTweenIndex] = tweens.end[k];
+		m_easing[m_lastTweenIndex] = tweens.easing[k];
+		m_flags[m_lastTweenIndex] = tweens.flags[k];
+		SetTiming(m_lastTweenIndex, tweens.duration[k], tweens.timeCounter[k]);
+		ResolveValues(m_lastTweenIndex);
+
+		m_group[m_lastTweenIndex] = AcquireGroup(tweens.group[k]);
+
+		if (!(tweens.flags[k] & (FlagFinishCallback | FlagStepCallback | FlagChain | FlagDelayed | FlagLoop)))
+		{
+			continue;
+		}
+		TweenCold& cold = OwnCold(m_lastTweenIndex);
+		if (tweens.flags[k] & (FlagFinishCallback | FlagStepCallback | FlagChain))
+		{
+			cold.source = sequence;
+			cold.sourceIndex = static_cast<unsigned int>(k);
+		}
+		if (tweens.flags[k] & FlagDelayed)
+		{
+			cold.delay = tweens.delay[k];
+			m_hasPendingDelays = true;
+		}
+		if (tweens.flags[k] & FlagLoop)
+		{
+			cold.loops = tweens.loops[k];
+		}
+	}
+}
+
+template<class T, class Alloc>std::shared_ptr<const TweenSequence<T, Alloc>> STween<T, Alloc>::MakeSequence() const
+{
+	std::shared_ptr<TweenSequence<T, Alloc>> sequence = std::allocate_shared<TweenSequence<T, Alloc>>(m_allocator, m_allocator);
+
+	for (size_t i = 0; i < m_flags.size(); ++i)
+	{
+		AppendToSequence(*sequence, *this, i);
+	}
+
+	if (m_parked)
+	{
+		for (size_t i = 0; i < m_parked->m_flags.size(); ++i)
+		{
+			AppendToSequence(*sequence, *m_parked, i);
+		}
+	}
+
+	return sequence;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::AppendToSequence(TweenSequence<T, Alloc>& sequence, const STween& storage, size_t index) const
+{
+	// Nobody could resume a paused copy
+	const float delay = DelayOf(storage, index);
+	const PlayState play = PlayOf(storage, index);
+	unsigned char flags = play.flags & ~(FlagPaused | FlagDelayed);
+	if (delay > 0)
+		flags |= FlagDelayed;
+
+	sequence.timeCounter.push_back(play.progress * storage.m_duration[index]);
+	sequence.duration.push_back(storage.m_duration[index]);
+	sequence.start.push_back(storage.m_start[index]);
+	sequence.end.push_back(storage.m_end[index]);
+	sequence.easing.push_back(storage.m_easing[index]);
+	sequence.target.push_back(storage.m_target[index]);
+	sequence.flags.push_back(flags);
+	sequence.delay.push_back(delay);
+	sequence.group.push_back(m_groupRefs[storage.m_group[index]].group);
+	sequence.loops.push_back((flags & FlagLoop) ? play.loops : 0);
+	sequence.callbacks.push_back(storage.CallbacksOf(index));
+}
+
+template<class T, class Alloc>std::vector<TweenData<T>> STween<T, Alloc>::SequenceToData(const TweenSequence<T, Alloc>& sequence)
+{
+	std::vector<TweenData<T>> tweens;
+	tweens.reserve(sequence.flags.size());
+
+	for (size_t i = 0; i < sequence.flags.size(); ++i)
+	{
+		const unsigned char flags = sequence.flags[i];
+		TweenData<T> tween(static_cast<int>(i));
+		tween.fromReady = (flags & FlagReady) != 0;
+		tween.byPointer = sequence.target[i] != nullptr;
+		tween.reversed = (flags & FlagReversed) != 0;
+		tween.initialValue = sequence.target[i];
+		tween.initialCpy = sequence.start[i];
+		tween.finalValue = sequence.end[i];
+		tween.duration = sequence.duration[i];
+		tween.easing = sequence.easing[i];
+		tween.timeCounter = sequence.timeCounter[i];
+		tween.delay = sequence.delay[i];
+		tween.group = sequence.group[i];
+		if (flags & FlagLoop)
+		{
+			const unsigned int loops = sequence.loops[i] & ~YoyoBit;
+			tween.loops = loops == LoopsForever ? ~0u : loops;
+			tween.yoyo = (sequence.loops[i] & YoyoBit) != 0;
+		}
+		if (sequence.callbacks[i].finishCallback)
+			tween.finishCallback = sequence.callbacks[i].finishCallback;
+		if (sequence.callbacks[i].stepCallback)
+			tween.stepCallback = sequence.callbacks[i].stepCallback;
+		if (sequence.callbacks[i].endTween)
+		{
+			tween.endTween = SequenceToData(*sequence.callbacks[i].endTween);
+		}
+		tweens.push_back(std::move(tween));
+	}
+
+	return tweens;
+}
+
+template<class T, class Alloc> template<class Tweens> std::shared_ptr<const TweenSequence<T, Alloc>> STween<T, Alloc>::DataToSequence(Tweens&& tweens) const
+{
+	std::shared_ptr<TweenSequence<T, Alloc>> sequence = std::allocate_shared<TweenSequence<T, Alloc>>(m_allocator, m_allocator);
+
+	for (auto &tween : tweens)
+	{
+		unsigned char flags = 0;
+		if (tween.fromReady)
+			flags |= FlagReady;
+		if (tween.reversed)
+			flags |= FlagReversed;
+		if (tween.finishCallback)
+			flags |= FlagFinishCallback;
+		if (tween.stepCallback)
+			flags |= FlagStepCallback;
+		if (!tween.endTween.empty())
+			flags |= FlagChain;
+		if (tween.delay > 0)
+			flags |= FlagDelayed;
+		const unsigned int loops = EncodeLoops(tween.loops, tween.yoyo);
+		if (loops)
+			flags |= FlagLoop;
+
+		TweenCallbacks<T, Alloc> callbacks;
+		callbacks.finishCallback = Detail::ForwardFrom<Tweens>(tween.finishCallback);
+		callbacks.stepCallback = Detail::ForwardFrom<Tweens>(tween.stepCallback);
+		if (!tween.endTween.empty())
+		{
+			callbacks.endTween = DataToSequence(Detail::ForwardFrom<Tweens>(tween.endTween));
+		}
+
+		sequence->timeCounter.push_back(tween.timeCounter);
+		sequence->duration.push_back(tween.duration);
+		sequence->start.push_back(Detail::ForwardFrom<Tweens>(tween.initialCpy));
+		sequence->end.push_back(Detail::ForwardFrom<Tweens>(tween.finalValue));
+		sequence->easing.push_back(tween.easing);
+		sequence->target.push_back(tween.byPointer ? tween.initialValue : nullptr);
+		sequence->flags.push_back(flags);
+		sequence->delay.push_back(tween.delay > 0 ? tween.delay : 0.0f);
+		sequence->group.push_back(tween.group);
+		sequence->loops.push_back(loops);
+		sequence->callbacks.push_back(std::move(callbacks));
+	}
+
+	return sequence;
+}
+
+template<class T, class Alloc> template<class Callback> STween<T, Alloc>& STween<T, Alloc>::OnFinish(Callback endCallback)
+{
+	OwnCallbacks(m_lastTweenIndex).finishCallback = TweenFunction<void()>(std::allocator_arg, m_allocator, std::move(endCallback));
+	if (ColdOf(m_lastTweenIndex).callbacks.finishCallback)
+		m_flags[m_lastTweenIndex] |= FlagFinishCallback;
+	else
+		m_flags[m_lastTweenIndex] &= ~FlagFinishCallback;
+
+	return *this;
+}
+
+template<class T, class Alloc> template<class Callback> STween<T, Alloc>& STween<T, Alloc>::OnStep(Callback callback)
+{
+	OwnCallbacks(m_lastTweenIndex).stepCallback = TweenFunction<void(T&)>(std::allocator_arg, m_allocator, std::move(callback));
+	if (ColdOf(m_lastTweenIndex).callbacks.stepCallback)
+		m_flags[m_lastTweenIndex] |= FlagStepCallback;
+	else
+		m_flags[m_lastTweenIndex] &= ~FlagStepCallback;
+
+	return *this;
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::Chain(STween<T, Alloc>* chain)
+{
+	return Chain(chain->MakeSequence());
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::Chain(std::shared_ptr<const TweenSequence<T, Alloc>> sequence)
+{
+	const bool hasTweens = sequence && !sequence->flags.empty();
+	OwnCallbacks(m_lastTweenIndex).endTween = std::move(sequence);
+	if (hasTweens)
+		m_flags[m_lastTweenIndex] |= FlagChain;
+	else
+		m_flags[m_lastTweenIndex] &= ~FlagChain;
+
+	return *this;
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::Reversed(bool isReversed)
+{
+	if (isReversed)
+		m_flags[m_lastTweenIndex] |= FlagReversed;
+	else
+		m_flags[m_lastTweenIndex] &= ~FlagReversed;
+	ResolveValues(m_lastTweenIndex);
+
+	return *this;
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::Loop(unsigned int count)
+{
+	SetLoops(m_lastTweenIndex, count > 1 ? std::min(count - 1, LoopsForever - 1) : 0, false);
+
+	return *this;
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::Yoyo(unsigned int count)
+{
+	SetLoops(m_lastTweenIndex, count > 1 ? std::min(count - 1, LoopsForever - 1) : 0, true);
+
+	return *this;
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::LoopForever(bool yoyo)
+{
+	SetLoops(m_lastTweenIndex, LoopsForever, yoyo);
+
+	return *this;
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::Delay(float sec)
+{
+	if (sec > 0)
+	{
+		m_flags[m_lastTweenIndex] |= FlagDelayed;
+		OwnCold(m_lastTweenIndex).delay = sec;
+		m_hasPendingDelays = true;
+	}
+	else
+	{
+		m_flags[m_lastTweenIndex] &= ~FlagDelayed;
+	}
+
+	return *this;
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::Owner(unsigned int id)
+{
+	if (id || m_coldOf[m_lastTweenIndex])
+	{
+		OwnCold(m_lastTweenIndex).owner = id;
+	}
+	m_hasUnsortedTargets = true;
+
+	return *this;
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::Group(const TweenGroup* group)
+{
+	const unsigned int previous = m_group[m_lastTweenIndex];
+	m_group[m_lastTweenIndex] = AcquireGroup(group);
+	ReleaseGroup(previous);
+
+	return *this;
+}
+
+template<class T, class Alloc>STween<T, Alloc>& STween<T, Alloc>::Easing(EasingFunction easingType)
+{
+	m_easing[m_lastTweenIndex] = easingType;
+
+	return *this;
+}
+
+template<class T, class Alloc>std::vector<TweenData<T>> STween<T, Alloc>::GetTweens()
+{
+	std::vector<TweenData<T>> tweens;
+	tweens.reserve(Size());
+
+	for (size_t i = 0; i < m_flags.size(); ++i)
+	{
+		tweens.push_back(ToData(*this, i));
+	}
+
+	if (m_parked)
+	{
+		for (size_t i = 0; i < m_parked->m_flags.size(); ++i)
+		{
+			tweens.push_back(ToData(*m_parked, i));
+		}
+	}
+
+	return tweens;
+}
+
+template<class T, class Alloc>TweenData<T> STween<T, Alloc>::ToData(const STween& storage, size_t index) const
+{
+	const PlayState play = PlayOf(storage, index);
+	const unsigned char flags = play.flags;
+	TweenData<T> tween(static_cast<int>(index));
+	tween.fromReady = (flags & FlagReady) != 0;
+	tween.byPointer = storage.m_target[index] != nullptr;
+	tween.reversed = (flags & FlagReversed) != 0;
+	tween.initialValue = storage.m_target[index];
+	tween.initialCpy = storage.m_start[index];
+	tween.finalValue = storage.m_end[index];
+	tween.duration = storage.m_duration[index];
+	tween.easing = storage.m_easing[index];
+	tween.timeCounter = play.progress * storage.m_duration[index];
+	tween.delay = DelayOf(storage, index);
+	tween.group = m_groupRefs[storage.m_group[index]].group;
+	if (flags & FlagLoop)
+	{
+		const unsigned int loops = play.loops & ~YoyoBit;
+		tween.loops = loops == LoopsForever ? ~0u : loops;
+		tween.yoyo = (play.loops & YoyoBit) != 0;
+	}
+	const TweenCallbacks<T, Alloc>& callbacks = storage.CallbacksOf(index);
+	if (callbacks.finishCallback)
+		tween.finishCallback = callbacks.finishCallback;
+	if (callbacks.stepCallback)
+		tween.stepCallback = callbacks.stepCallback;
+	if (callbacks.endTween)
+	{
+		tween.endTween = SequenceToData(*callbacks.endTween);
+	}
+
+	return tween;
+}
+
+template<class T, class Alloc>TweenHandle STween<T, Alloc>::AddTween(const TweenData<T>& STween)
+{
+	return AddTweenData(STween);
+}
+
+template<class T, class Alloc>TweenHandle STween<T, Alloc>::AddTween(TweenData<T>&& STween)
+{
+	return AddTweenData(std::move(STween));
+}
+
+template<class T, class Alloc> template<class Data> TweenHandle STween<T, Alloc>::AddTweenData(Data&& STween)
+{
+	PushTween(STween.byPointer ? STween.initialValue : nullptr, STween.initialCpy);
+
+	m_end[m_lastTweenIndex] = Detail::ForwardFrom<Data>(STween.finalValue);
+	m_easing[m_lastTweenIndex] = STween.easing;
+	SetTiming(m_lastTweenIndex, STween.duration, STween.timeCounter);
+
+	unsigned char flags = 0;
+	if (STween.fromReady)
+		flags |= FlagReady;
+	if (STween.reversed)
+		flags |= FlagReversed;
+	if (STween.finishCallback)
+		flags |= FlagFinishCallback;
+	if (STween.stepCallback)
+		flags |= FlagStepCallback;
+	if (!STween.endTween.empty())
+		flags |= FlagChain;
+	m_flags[m_lastTweenIndex] = flags;
+	ResolveValues(m_lastTweenIndex);
+	Delay(STween.delay);
+	Group(STween.group);
+	const unsigned int loops = EncodeLoops(STween.loops, STween.yoyo);
+	SetLoops(m_lastTweenIndex, loops & ~YoyoBit, (loops & YoyoBit) != 0);
+
+	if (flags & (FlagFinishCallback | FlagStepCallback | FlagChain))
+	{
+		TweenCallbacks<T, Alloc>& callbacks = OwnCold(m_lastTweenIndex).callbacks;
+		callbacks.finishCallback = Detail::ForwardFrom<Data>(STween.finishCallback);
+		callbacks.stepCallback = Detail::ForwardFrom<Data>(STween.stepCallback);
+		if (!STween.endTween.empty())
+		{
+			callbacks.endTween = DataToSequence(Detail::ForwardFrom<Data>(STween.endTween));
+		}
+	}
+
+	return GetHandle();
+}
+
+template<class T, class Alloc>void STween<T, Alloc>::Splice(STween& other)
+{
+	if (&other == this)
+	{
+		return;
+	}
+
+	// Waiting tweens come along and are parked here on the next Update(),
+	// pulled ones with the progress they reached
+	if (other.m_pullMode)
+	{
+		other.StopAllPulled();
+	}
+	other.UnparkAll();
+	m_hasPendingDelays = m_hasPendingDelays || other.m_hasPendingDelays;
+	other.m_hasPendingDelays = false;
+
+	// Handles of 'other' expire before its slot indices get overwritten
+	for (size_t i = 0; i < other.m_slotOf.size(); ++i)
+	{
+		other.ReleaseSlot(i);
+	}
+
+	const size_t first = m_flags.size();
+	Detail::ColumnAppend append;
+	ForEachColumnPair(other, append);
+	for (size_t i = first; i < m_flags.size(); ++i)
+	{
+		AdoptCold(other, i - first, i);
+	}
+	other.TruncateTweens(0);
+	m_hasUnsortedTargets = true;
+
+	for (size_t i = first; i < m_flags.size(); ++i)
+	{
+		m_slotOf[i] = AcquireSlot(i);
+		m_group[i] = AcquireGroup(other.m_groupRefs[m_group[i]].group);
+		AnchorTicks(i);
+		if (m_coalesceTargets && m_target[i])
+		{
+			ClaimTarget(m_target[i], HandleOf(i));
+		}
+		// Killed ones are dropped with the others, the rest start on the next Update()
+		if (m_pullMode && !(m_flags[i] & FlagReady))
+		{
+			PushDead(i);
+		}
+	}
+	other.m_groupRefs.resize(1);
+	other.m_wakeHeaps.erase(other.m_wakeHeaps.begin() + 1, other.m_wakeHeaps.end());
+	other.m_finishHeaps.erase(other.m_finishHeaps.begin() + 1, other.m_finishHeaps.end());
+	m_lastTweenIndex = static_cast<int>(m_flags.size()) - 1;
+}
+
+template<class T, class Alloc>size_t STween<T, Alloc>::Size() const
+{
+	return m_flags.size() + (m_parked ? m_parked->m_flags.size() : 0);
+}
+
+template<class T, class Alloc>TweenView<T> STween<T, Alloc>::View() const
+{
+	TweenView<T> view;
+	view.size = m_flags.size();
+	view.progress = TweenSpan<const float>(m_progress.data(), view.size);
+	view.duration = TweenSpan<const float>(m_duration.data(), view.size);
+	view.start = TweenSpan<const T>(m_start.data(), view.size);
+	view.end = TweenSpan<const T>(m_end.data(), view.size);
+	view.easing = TweenSpan<const EasingFunction>(m_easing.data(), view.size);
+	view.target = TweenSpan<T* const>(m_target.data(), view.size);
+	return view;
+}
+
+template<class T, class Alloc>TweenHandle STween<T, Alloc>::GetHandle() const
+{
+	if (m_lastTweenIndex < 0)
+	{
+		return TweenHandle();
+	}
+
+	const unsigned int slot = m_slotOf[m_lastTweenIndex];
+	if (slot == NoIndex)
+	{
+		return TweenHandle();
+	}
+
+	return TweenHandle(slot, m_slots[slot].generation);
+}
+
+template<class T, class Alloc>bool STween<T, Alloc>::IsAlive(TweenHandle handle) const
+{
+	return IndexOf(handle) != NoIndex || ParkedIndexOf(handle) != NoIndex;
+}
+
+template<class T, class Alloc>bool STween<T, Alloc>::Kill(TweenHandle handle)
+{
+	unsigned int index;
+	STween* storage = Locate(handle, index);
+	if (!storage)
+	{
+		return false;
+	}
+
+	if (storage != this)
+	{
+		// The heap entry goes stale and is skipped when it comes up
+		FreeSlot(handle.index);
+		ReleaseGroup(m_parked->m_group[index]);
+		RemoveParked(index);
+		return true;
+	}
+
+	// Storage is reclaimed on the next Update()
+	m_flags[index] &= ~FlagReady;
+	ReleaseSlot(index);
+	if (m_pullMode)
+	{
+		PushDead(index);
+	}
+
+	return true;
+}
+
+template<class T, class Alloc>bool STween<T, Alloc>::Pause(TweenHandle handle)
+{
+	unsigned int index;
+	STween* storage = Locate(handle, index);
+	if (!storage)
+	{
+		return false;
+	}
+
+	// A waiting tween keeps the delay it has left, its heap entry is skipped when it comes up
+	if (storage != this && !(storage->m_flags[index] & FlagPaused))
+	{
+		m_parkedWake[index] -= m_groupRefs[storage->m_group[index]].time;
+	}
+	// Same for the finish entry of a pulled tween, which keeps its progress
+	if (storage == this && IsPulled(index))
+	{
+		StopPulled(index);
+	}
+	storage->m_flags[index] |= FlagPaused;
+
+	return true;
+}
+
+template<class T, class Alloc>bool STween<T, Alloc>::Resume(TweenHandle handle)
+{
+	unsigned int index;
+	STween* storage = Locate(handle, index);
+	if (!storage)
+	{
+		return false;
+	}
+
+	// A waiting tween waits what it had left from now on
+	if (storage != this && (storage->m_flags[index] & FlagPaused))
+	{
+		m_parkedWake[index] += m_groupRefs[storage->m_group[index]].time;
+		PushTimer(m_wakeHeaps[storage->m_group[index]], handle.index, m_parkedWake[index]);
+	}
+	const bool paused = (storage->m_flags[index] & FlagPaused) != 0;
+	storage->m_flags[index] &= ~FlagPaused;
+	if (storage == this && paused && IsPulled(index))
+	{
+		StartPulled(index);
+	}
+
+	return true;
+}
+
+template<class T, class Alloc>bool STween<T, Alloc>::Seek(TweenHandle handle, float sec)
+{
+	unsigned int index;
+	STween* storage = Locate(handle, index);
+	if (!storage)
+	{
+		return false;
+	}
+
+	const bool pulled = storage == this && IsPulled(index);
+	if (pulled)
+	{
+		StopPulled(index);
+	}
+	storage->SetTiming(index, storage->m_duration[index], sec);
+	if (pulled)
+	{
+		StartPulled(index);
+	}
+
+	return true;
+}
+
+template<class T, class Alloc>bool STween<T, Alloc>::Sample(TweenHandle handle, T& value) const
+{
+	unsigned int index = IndexOf(handle);
+	const STween* storage = this;
+	if (index == NoIndex)
+	{
+		index = ParkedIndexOf(handle);
+		storage = m_parked.get();
+		if (index == NoIndex)
+		{
+			return false;
+		}
+	}
+
+	const PlayState play = PlayOf(*storage, index);
+	value = ValueAt(*storage, index, play.progress, (play.flags & FlagReversed) != 0);
+
+	return true;
+}
+
+template<class T, class Alloc>bool STween<T, Alloc>::SampleAt(TweenHandle handle, float sec, T& value) const
+{
+	unsigned int index = IndexOf(handle);
+	const STween* storage = this;
+	if (index == NoIndex)
+	{
+		index = ParkedIndexOf(handle);
+		storage = m_parked.get();
+		if (index == NoIndex)
+		{
+			return false;
+		}
+	}
+
+	const float progress = storage->m_invDuration[index] > 0 ? sec * storage->m_invDuration[index] : 1.0f;
+	value = ValueAt(*storage, index, progress, (storage->m_flags[index] & FlagReversed) != 0);
+
+	return true;
+}
+
+template<class T, class Alloc>T STween<T, Alloc>::ValueAt(const STween& storage, size_t index, float progress, bool reversed) const
+{
+	// Same value Update() snaps to once finished
+	if (progress >= 1.0f)
+	{
+		return reversed ? storage.m_start[index] : storage.m_end[index];
+	}
+
+	const float position = progress > 0 ? progress : 0.0f;
+	const EasingFunction easing = storage.m_easing[index];
+	const float eased = m_sampledEasing ? m_sampledEasing->Evaluate(easing, position) : Detail::Ease(easing, position);
+	if (reversed == ((storage.m_flags[index] & FlagReversed) != 0))
+	{
+		return Detail::Lanes<T>::Evaluate(storage.m_base[index], storage.m_delta[index], eased);
+	}
+
+	// A pulled yoyo that turned around since its start time
+	T base;
+	Delta delta;
+	if (reversed)
+		Detail::Lanes<T>::Resolve(storage.m_end[index], storage.m_start[index], base, delta);
+	else
+		Detail::Lanes<T>::Resolve(storage.m_start[index], storage.m_end[index], base, delta);
+	return Detail::Lanes<T>::Evaluate(base, delta, eased);
+}
+
+template<class T, class Alloc>bool STween<T, Alloc>::Retarget(TweenHandle handle, const T& finalVal, bool keepVelocity)
+{
+	unsigned int index;
+	STween* storage = Locate(handle, index);
+	if (!storage)
+	{
+		return false;
+	}
+
+	if (storage != this)
+	{
+		// Not started yet, the final value is the end it reaches
+		((m_parked->m_flags[index] & FlagReversed) ? m_parked->m_start[index] : m_parked->m_end[index]) = finalVal;
+		m_parked->ResolveValues(index);
+		return true;
+	}
+
+	// Changed as in push mode, then started again from where it is
+	const bool pulled = IsPulled(index);
+	if (pulled)
+	{
+		StopPulled(index);
+	}
+	const float progress = m_progress[index];
+	const bool reversed = (m_flags[index] & FlagReversed) != 0;
+	const T current = ValueAt(*this, index, progress, reversed);
+	const EasingFunction easing = m_easing[index];
+	const float position = progress > 0 ? progress : 0.0f;
+	const float eased = progress < 1.0f ? (m_sampledEasing ? m_sampledEasing->Evaluate(easing, position) : Detail::Ease(easing, position)) : 1.0f;
+
+	// Slope of the easing curve where it is, by central difference
+	const float step = 1.0e-3f;
+	const float low = std::max(position - step, 0.0f);
+	const float high = std::min(position + step, 1.0f);
+	const float slope = progress < 1.0f ? (Detail::Ease(easing, high) - Detail::Ease(easing, low)) / (high - low) : 0.0f;
+
+	// Reversed tweens, yoyos on their way back included, head to m_start
+	T& from = reversed ? m_end[index] : m_start[index];
+	T& to = reversed ? m_start[index] : m_end[index];
+	T base;
+	Delta left;
+	Delta ahead;
+	Detail::Lanes<T>::Resolve(current, to, base, left);
+	Detail::Lanes<T>::Resolve(current, finalVal, base, ahead);
+	const float leftLength = Detail::Lanes<T>::Length(left);
+	const float aheadLength = Detail::Lanes<T>::Length(ahead);
+	to = finalVal;
+	if (keepVelocity && m_invDuration[index] > 0 && 1.0f - eased > 1.0e-3f && std::fabs(slope) > 1.0e-3f && leftLength > 0 && aheadLength > 0)
+	{
+		// Origin moved so the curve through the current value at this progress ends at finalVal:
+		// from = finalVal + (current - finalVal) / (1 - eased)
+		Delta back;
+		Detail::Lanes<T>::Resolve(finalVal, current, base, back);
+		from = Detail::Lanes<T>::Evaluate(finalVal, back, 1.0f / (1.0f - eased));
+		ResolveValues(index);
+
+		// Speed is |to - from| * slope * invDuration where |to - from| is what is left over (1 - eased),
+		// so the new invDuration is the old one times the ratio of what was left to what is left now
+		const float duration = m_duration[index] * aheadLength / leftLength;
+		SetTiming(index, duration, progress * duration);
+	}
+	else
+	{
+		from = current;
+		ResolveValues(index);
+		SetTiming(index, m_duration[index], 0);
+	}
+	if (pulled)
+	{
+		StartPulled(index);
+	}
+
+	return true;
+}
+
+#ifdef STWEEN_COROUTINES
+template<class T, class Alloc>TweenAwaiter<1> STween<T, Alloc>::Play(TweenHandle handle)
+{
+	const TweenAwaitEntry entry = { this, handle, &STween::LinkWaiter };
+	return TweenAwaiter<1>(entry);
+}
+
+template<class T, class Alloc> template<class... Handles> TweenAwaiter<sizeof...(Handles)> STween<T, Alloc>::AllOf(Handles... handles)
+{
+	return TweenAwaiter<sizeof...(Handles)>(TweenAwaitEntry{ this, handles, &STween::LinkWaiter }...);
+}
+#endif
+
+template<class T, class Alloc> void STween<T, Alloc>::SetCoalesceTargets(bool enabled)
+{
+	m_coalesceTargets = enabled;
+	if (enabled)
+	{
+		RebuildTargetIndex();
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::SetSortedTargets(bool enabled)
+{
+	m_sortedTargets = enabled;
+	m_hasUnsortedTargets = true;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::SetSeparateWrites(bool enabled)
+{
+	m_separateWrites = enabled;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::SetOutputBuffer(TweenSpan<T> buffer)
+{
+	m_outputBuffer = buffer;
+	m_hasUnsortedTargets = true;
+}
+
+template<class T, class Alloc>T* STween<T, Alloc>::TargetOf(size_t index) const
+{
+	T* target = m_target[index];
+	if (!target && m_slotOf[index] < m_outputBuffer.size())
+	{
+		target = m_outputBuffer.data() + m_slotOf[index];
+	}
+	return target;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::SortTargets()
+{
+	m_hasUnsortedTargets = false;
+	const size_t count = m_flags.size();
+	ResizeScratch(m_sortKeys, count);
+
+	// Tweens before 'sorted' are still in order from the previous sort
+	size_t sorted = count;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const SortKey key = { ColdOf(i).owner, m_target[i], m_slotOf[i], static_cast<unsigned int>(i) };
+		m_sortKeys[i] = key;
+		if (sorted == count && i > 0 && SortsBefore()(key, m_sortKeys[i - 1]))
+		{
+			sorted = i;
+		}
+	}
+	if (sorted == count)
+	{
+		return;
+	}
+
+	ResizeScratch(m_sortMerged, count);
+	std::sort(m_sortKeys.begin() + sorted, m_sortKeys.end(), SortsBefore());
+	std::merge(m_sortKeys.begin(), m_sortKeys.begin() + sorted, m_sortKeys.begin() + sorted, m_sortKeys.end(), m_sortMerged.begin(), SortsBefore());
+
+	// Position j takes the tween at m_sortMerged[j].index,
+	// each cycle of the permutation is followed with swaps and marked done by pointing to itself
+	for (size_t j = 0; j < count; ++j)
+	{
+		size_t k = j;
+		while (m_sortMerged[k].index != j)
+		{
+			const size_t next = m_sortMerged[k].index;
+			SwapTweens(k, next);
+			m_sortMerged[k].index = static_cast<unsigned int>(k);
+			k = next;
+		}
+		m_sortMerged[k].index = static_cast<unsigned int>(k);
+	}
+	m_lastTweenIndex = static_cast<int>(count) - 1;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::SwapTweens(size_t a, size_t b)
+{
+	Detail::ColumnSwap swap = { a, b };
+	ForEachColumn(swap);
+
+	if (m_slotOf[a] != NoIndex)
+	{
+		m_slots[m_slotOf[a]].index = static_cast<unsigned int>(a);
+	}
+	if (m_slotOf[b] != NoIndex)
+	{
+		m_slots[m_slotOf[b]].index = static_cast<unsigned int>(b);
+	}
+}
+
+template<class T, class Alloc>TweenHandle STween<T, Alloc>::FindTarget(const T* target) const
+{
+	if (!m_coalesceTargets || !target || m_targetIndex.empty())
+	{
+		return TweenHandle();
+	}
+
+	const size_t mask = m_targetIndex.size() - 1;
+	for (size_t k = Detail::HashPointer(target) & mask; m_targetIndex[k].target; k = (k + 1) & mask)
+	{
+		if (m_targetIndex[k].target == target)
+		{
+			return IsAlive(m_targetIndex[k].handle) ? m_targetIndex[k].handle : TweenHandle();
+		}
+	}
+
+	return TweenHandle();
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::ClaimTarget(const T* target, TweenHandle handle)
+{
+	if (2 * (m_targetEntries + 1) > m_targetIndex.size())
+	{
+		// The new tween is already in the arrays and comes back in the rebuild
+		RebuildTargetIndex();
+	}
+
+	// Looks for 'target' down the whole probe chain, reusing the first entry of a finished tween if it isn't there
+	const size_t mask = m_targetIndex.size() - 1;
+	size_t reuse = m_targetIndex.size();
+	size_t k = Detail::HashPointer(target) & mask;
+	for (; m_targetIndex[k].target; k = (k + 1) & mask)
+	{
+		TargetEntry& entry = m_targetIndex[k];
+		if (entry.target == target)
+		{
+			if (entry.handle != handle)
+			{
+				Kill(entry.handle);
+				entry.handle = handle;
+			}
+			return;
+		}
+
+		if (reuse == m_targetIndex.size() && !IsAlive(entry.handle))
+		{
+			reuse = k;
+		}
+	}
+
+	if (reuse == m_targetIndex.size())
+	{
+		reuse = k;
+		++m_targetEntries;
+	}
+	m_targetIndex[reuse].target = target;
+	m_targetIndex[reuse].handle = handle;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::RebuildTargetIndex()
+{
+	size_t live = 0;
+	for (size_t i = 0; i < m_flags.size(); ++i)
+	{
+		live += m_target[i] && (m_flags[i] & FlagReady);
+	}
+	if (m_parked)
+	{
+		live += m_parked->m_flags.size();
+	}
+
+	size_t size = 16;
+	while (size < 4 * (live + 1))
+	{
+		size *= 2;
+	}
+	size = std::max(size, m_targetIndex.size());
+#ifdef STWEEN_TRACK_ALLOCATIONS
+	m_allocationCount += size > m_targetIndex.capacity();
+#endif
+	const TargetEntry empty = { nullptr, TweenHandle() };
+	m_targetIndex.assign(size, empty);
+	m_targetEntries = 0;
+
+	// Later tweens win over earlier ones writing to the same target
+	for (size_t i = 0; i < m_flags.size(); ++i)
+	{
+		if (m_target[i] && (m_flags[i] & FlagReady))
+		{
+			ClaimTarget(m_target[i], HandleOf(i));
+		}
+	}
+	if (m_parked)
+	{
+		for (size_t i = 0; i < m_parked->m_flags.size(); ++i)
+		{
+			const unsigned int slot = m_parked->m_slotOf[i];
+			if (m_parked->m_target[i] && slot != NoIndex)
+			{
+				ClaimTarget(m_parked->m_target[i], TweenHandle(slot, m_slots[slot].generation));
+			}
+		}
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::SetPullMode(bool enabled)
+{
+	if (enabled == m_pullMode)
+	{
+		return;
+	}
+
+	// Tweens get their start times on the next Update(), and give them back when leaving
+	if (enabled)
+	{
+		CompactTweens();
+		m_pulledCount = 0;
+	}
+	else
+	{
+		StopAllPulled();
+	}
+	m_pullMode = enabled;
+}
+
+template<class T, class Alloc> bool STween<T, Alloc>::IsPulled(size_t index) const
+{
+	return m_pullMode && index < m_pulledCount && (m_flags[index] & (FlagReady | FlagPaused)) == FlagReady;
+}
+
+template<class T, class Alloc> typename STween<T, Alloc>::PlayState STween<T, Alloc>::PlayOf(const STween& storage, size_t index) const
+{
+	const unsigned char flags = storage.m_flags[index];
+	PlayState play = { storage.m_progress[index], flags, (flags & FlagLoop) ? storage.ColdOf(index).loops : 0 };
+	if (&storage != this || !IsPulled(index))
+	{
+		return play;
+	}
+
+	const float invDuration = m_invDuration[index];
+	if (invDuration <= 0)
+	{
+		play.progress = 1.0f;
+		play.flags &= ~FlagLoop;
+		return play;
+	}
+
+	play.progress = static_cast<float>((m_groupRefs[m_group[index]].time - m_startTime[index]) * invDuration);
+	if ((flags & FlagLoop) && play.progress >= 1.0f)
+	{
+		WrapPlays(play);
+	}
+	return play;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::StartPulled(size_t index)
+{
+	const float invDuration = m_invDuration[index];
+	const double now = m_groupRefs[m_group[index]].time;
+	m_startTime[index] = now - (invDuration > 0 ? static_cast<double>(m_progress[index]) * m_duration[index] : 0.0);
+
+	double finish;
+	if (FinishTimeOf(index, finish))
+	{
+		PushTimer(m_finishHeaps[m_group[index]], m_slotOf[index], finish);
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::StartAddedPulled()
+{
+	for (size_t i = m_pulledCount; i < m_flags.size(); ++i)
+	{
+		if ((m_flags[i] & (FlagReady | FlagPaused)) == FlagReady)
+		{
+			StartPulled(i);
+		}
+	}
+	m_pulledCount = m_flags.size();
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::StopPulled(size_t index)
+{
+	// Its finish entry no longer matches FinishTimeOf() and is skipped
+	ApplyPlay(index, PlayOf(*this, index));
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::StopAllPulled()
+{
+	ReclaimPulled();
+	for (size_t i = 0; i < m_pulledCount; ++i)
+	{
+		if (IsPulled(i))
+		{
+			StopPulled(i);
+		}
+	}
+	for (size_t k = 0; k < m_finishHeaps.size(); ++k)
+	{
+		m_finishHeaps[k].clear();
+	}
+	m_pulledCount = 0;
+}
+
+template<class T, class Alloc> bool STween<T, Alloc>::FinishTimeOf(size_t index, double& time) const
+{
+	if (m_invDuration[index] <= 0)
+	{
+		time = m_startTime[index];
+		return true;
+	}
+
+	unsigned int plays = 1;
+	if (m_flags[index] & FlagLoop)
+	{
+		const unsigned int left = ColdOf(index).loops & ~YoyoBit;
+		if (left == LoopsForever)
+		{
+			return false;
+		}
+		plays += left;
+	}
+	time = m_startTime[index] + static_cast<double>(m_duration[index]) * plays;
+	return true;
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::FinishPulled()
+{
+	// Callbacks may add groups, the heaps are looked up again after each one
+	for (size_t k = 0; k < m_finishHeaps.size(); ++k)
+	{
+		const double now = m_groupRefs[k].time;
+		while (!m_finishHeaps[k].empty() && m_finishHeaps[k].front().time <= now)
+		{
+			TweenVector<TweenWake, Alloc>& heap = m_finishHeaps[k];
+			const TweenWake wake = heap.front();
+			std::pop_heap(heap.begin(), heap.end(), WakesLater());
+			heap.pop_back();
+
+			// Stale once the tween was killed, paused, sought or retargeted since
+			const unsigned int index = IndexOf(TweenHandle(wake.slot, wake.generation));
+			double finish;
+			if (index == NoIndex || !IsPulled(index) || !FinishTimeOf(index, finish) || finish != wake.time)
+			{
+				continue;
+			}
+
+			StopPulled(index);
+			PushDead(index);
+			FinishTween(index, m_flags[index], TargetOf(index));
+		}
+	}
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::PushDead(size_t index)
+{
+#ifdef STWEEN_TRACK_ALLOCATIONS
+	m_allocationCount += m_pulledDead.size() == m_pulledDead.capacity();
+#endif
+	m_pulledDead.push_back(static_cast<unsigned int>(index));
+}
+
+template<class T, class Alloc> void STween<T, Alloc>::ReclaimPulled()
+{
+	// From the back, so the tweens moved into the holes are never dead ones still to come
+	std::sort(m_pulledDead.begin(), m_pulledDead.end(), std::greater<unsigned int>());
+	for (size_t k = 0; k < m_pulledDead.size(); ++k)
+	{
+		const size_t dead = m_pulledDead[k];
+		ReleaseGroup(m_group[dead]);
+		ReleaseSlot(dead);
+		FreeCold(dead);
+
+		// The last pulled tween fills the hole so the ones added since stay after m_pulledCount
+		size_t hole = dead;
+		if (dead < m_pulledCount)
+		{
+			--m_pulledCount;
+			if (m_pulledCount != hole)
+			{
+				MoveTween(m_pulledCount, hole);
+			}
+			hole = m_pulledCount;
+		}
+		const size_t last = m_flags.size() - 1;
+		if (last != hole)
+		{
+			MoveTween(last, hole);
+		}
+		TruncateTweens(last);
+	}
+	m_pulledDead.clear();
+}
+
+template<class T, class Alloc>void STween<T, Alloc>::AddTweens(std::vector<TweenData<T>>&& tweens)
+{
+	for (auto &STween : tweens)
+	{
+		AddTween(std::move(STween));
+	}
+}
+
+template<class T, class Alloc>void STween<T, Alloc>::AddTweens(TweenSpan<const TweenData<T>> tweens)
+{
+	for (auto &STween : tweens)
+	{
+		AddTween(STween);
+	}
+}
+
+template<class T, class Alloc> template<class TargetId> void STween<T, Alloc>::SaveSnapshot(std::vector<unsigned char>& out, TargetId targetId) const
+{
+	static_assert(std::is_trivially_copyable<T>::value, "Snapshots store T as raw bytes");
+
+	// Killed tweens waiting for the next Update() are left out
+	size_t count = 0;
+	for (size_t i = 0; i < m_flags.size(); ++i)
+	{
+		count += (m_flags[i] & FlagReady) != 0;
+	}
+	const size_t parked = m_parked ? m_parked->m_flags.size() : 0;
+	count += parked;
+
+	const Detail::SnapshotLayout layout = Detail::SnapshotLayoutOf(count, sizeof(T));
+	const size_t offset = out.size();
+	out.resize(offset + layout.size);
+	unsigned char* data = out.data() + offset;
+
+	const TweenSnapshotHeader header = { TweenSnapshotHeader::Magic, TweenSnapshotHeader::Version, static_cast<unsigned int>(sizeof(T)), static_cast<unsigned int>(count) };
+	std::memcpy(data, &header, sizeof(header));
+
+	size_t entry = 0;
+	for (size_t i = 0; i < m_flags.size(); ++i)
+	{
+		if (m_flags[i] & FlagReady)
+		{
+			WriteSnapshotEntry(*this, i, entry++, data, layout, targetId);
+		}
+	}
+	for (size_t i = 0; i < parked; ++i)
+	{
+		WriteSnapshotEntry(*m_parked, i, entry++, data, layout, targetId);
+	}
+}
+
+template<class T, class Alloc> template<class TargetId> void STween<T, Alloc>::WriteSnapshotEntry(const STween& storage, size_t index, size_t entry, unsigned char* data, const Detail::SnapshotLayout& layout, TargetId& targetId) const
+{
+	const unsigned int slot = storage.m_slotOf[index];
+	const TweenHandle handle = slot != NoIndex ? TweenHandle(slot, m_slots[slot].generation) : TweenHandle();
+	const unsigned int id = targetId(handle, storage.m_target[index]);
+	const float delay = DelayOf(storage, index);
+	const int easing = static_cast<int>(storage.m_easing[index]);
+	const PlayState play = PlayOf(storage, index);
+	const unsigned char flags = play.flags & (FlagReversed | FlagPaused | FlagLoop);
+	const unsigned int loops = (flags & FlagLoop) ? play.loops : 0;
+
+	std::memcpy(data + layout.start + entry * sizeof(T), &storage.m_start[index], sizeof(T));
+	std::memcpy(data + layout.end + entry * sizeof(T), &storage.m_end[index], sizeof(T));
+	std::memcpy(data + layout.progress + entry * sizeof(float), &play.progress, sizeof(float));
+	std::memcpy(data + layout.duration + entry * sizeof(float), &storage.m_duration[index], sizeof(float));
+	std::memcpy(data + layout.delay + entry * sizeof(float), &delay, sizeof(float));
+	std::memcpy(data + layout.easing + entry * sizeof(int), &easing, sizeof(int));
+	std::memcpy(data + layout.id + entry * sizeof(unsigned int), &id, sizeof(unsigned int));
+	std::memcpy(data + layout.loops + entry * sizeof(unsigned int), &loops, sizeof(unsigned int));
+	data[layout.flags + entry] = flags;
+}
+
+template<class T, class Alloc> template<class Bind> bool STween<T, Alloc>::LoadSnapshot(const void* data, size_t size, Bind bind)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "Snapshots store T as raw bytes");
+	static_assert(sizeof(EasingFunction) == sizeof(int), "Easing blocks are copied straight into m_easing");
+
+	TweenSnapshotHeader header;
+	if (!data || size < sizeof(header))
+	{
+		return false;
+	}
+	std::memcpy(&header, data, sizeof(header));
+	if (header.magic != TweenSnapshotHeader::Magic || header.version != TweenSnapshotHeader::Version || header.valueSize != sizeof(T))
+	{
+		return false;
+	}
+
+	const size_t count = header.count;
+	const Detail::SnapshotLayout layout = Detail::SnapshotLayoutOf(count, sizeof(T));
+	if (size < layout.size)
+	{
+		return false;
+	}
+
+	// The arrays are resized in place, so restoring into a warm manager reuses their storage
+	// Every cold entry goes back to the pool, owner and delay included, nothing of the previous tweens leaks through
+	ReleaseReferences();
+	for (size_t i = 0; i < m_coldOf.size(); ++i)
+	{
+		FreeCold(i);
+	}
+	Detail::ColumnResize resize = { count };
+	ForEachColumn(resize);
+
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	if (count)
+	{
+		std::memcpy(m_start.data(), bytes + layout.start, count * sizeof(T));
+		std::memcpy(m_end.data(), bytes + layout.end, count * sizeof(T));
+		std::memcpy(m_progress.data(), bytes + layout.progress, count * sizeof(float));
+		std::memcpy(m_duration.data(), bytes + layout.duration, count * sizeof(float));
+		std::memcpy(m_easing.data(), bytes + layout.easing, count * sizeof(int));
+		std::memcpy(m_flags.data(), bytes + layout.flags, count);
+	}
+
+	const int easingCount = static_cast<int>(Detail::EasingCount());
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_flags[i] = FlagReady | (m_flags[i] & (FlagReversed | FlagPaused | FlagLoop));
+		// Custom curves not registered on this side fall back to Linear
+		const int easing = static_cast<int>(m_easing[i]);
+		if (easing < 0 || easing >= easingCount)
+		{
+			m_easing[i] = EasingFunction::Linear;
+		}
+		m_invDuration[i] = m_duration[i] > 0 ? 1.0f / m_duration[i] : 0.0f;
+		m_slotOf[i] = AcquireSlot(i);
+		m_group[i] = 0;
+		ResolveValues(i);
+		AnchorTicks(i);
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		float delay;
+		unsigned int id;
+		std::memcpy(&delay, bytes + layout.delay + i * sizeof(float), sizeof(float));
+		std::memcpy(&id, bytes + layout.id + i * sizeof(unsigned int), sizeof(unsigned int));
+		if (m_flags[i] & FlagLoop)
+		{
+			std::memcpy(&OwnCold(i).loops, bytes + layout.loops + i * sizeof(unsigned int), sizeof(unsigned int));
+		}
+
+		m_lastTweenIndex = static_cast<int>(i);
+		// Saved past its wake time, before an Update() woke it: starts with the time it is overdue
+		if (delay < 0)
+		{
+			m_progress[i] -= delay * m_invDuration[i];
+			AnchorTicks(i);
+		}
+		Delay(delay);
+		m_target[i] = bind(id);
+		m_hasUnsortedTargets = true;
+		if (m_coalesceTargets && m_target[i])
+		{
+			ClaimTarget(m_target[i], HandleOf(i));
+		}
+	}
+	m_lastTweenIndex = static_cast<int>(count) - 1;
+
+	return true;
+}
+
+template<class T, class Alloc>void STween<T, Alloc>::AddBatch(TweenSpan<T* const> targets, TweenSpan<const T> finals, float duration, EasingFunction easing)
+{
+	const size_t count = std::min(targets.size(), finals.size());
+	const size_t needed = m_flags.size() + count;
+	if (needed > m_flags.capacity())
+	{
+#ifdef STWEEN_TRACK_ALLOCATIONS
+		++m_allocationCount;
+#endif
+		// Geometric growth so many small batches stay amortized
+		Reserve(std::max(needed, 2 * m_flags.capacity()));
+	}
+
+	// Every array grows once, then tweens are written in place
+	const size_t first = m_flags.size();
+	Detail::ColumnResize resize = { first + count };
+	ForEachColumn(resize);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const size_t index = first + i;
+		T* target = targets[i];
+		m_start[index] = target ? *target : finals[i];
+		m_end[index] = finals[i];
+		m_easing[index] = easing;
+		m_target[index] = target;
+		m_flags[index] = FlagReady;
+		m_slotOf[index] = AcquireSlot(index);
+		m_group[index] = 0;
+		SetTiming(index, duration, 0);
+		ResolveValues(index);
+		if (m_coalesceTargets && target)
+		{
+			ClaimTarget(target, HandleOf(index));
+		}
+	}
+	m_hasUnsortedTargets = m_hasUnsortedTargets || count > 0;
+	m_lastTweenIndex = static_cast<int>(first + count) - 1;
+}
+
+template<class T, class Alloc>void STween<T, Alloc>::Reserve(size_t count)
+{
+	Detail::ColumnReserve reserve = { count };
+	ForEachColumn(reserve);
+	m_slots.reserve(count);
+	// deltaTime of each group used so far, this manager's clock included
+	m_groupDelta.reserve(m_groupRefs.size());
+
+	// Scratch buffers Update() needs for that many tweens with the features enabled so far
+	if (m_batchedEasing)
+	{
+		m_easeOrder.reserve(count);
+		m_easeBuffer.reserve(count);
+		m_eased.reserve(count);
+	}
+	if (m_jobSystem)
+	{
+		m_values.reserve(count);
+	}
+	if (m_sortedTargets)
+	{
+		m_sortKeys.reserve(count);
+		m_sortMerged.reserve(count);
+	}
+	if (m_separateWrites)
+	{
+		m_writeTargets.reserve(count);
+		m_writeValues.reserve(count);
+	}	if (m_pullMode)
+	{
+		m_pulledDead.reserve(count);
+		for (size_t k = 0; k < m_finishHeaps.size(); ++k)
+		{
+			m_finishHeaps[k].reserve(count);
+		}
+	}
+}
+
+// Chain graph of a TweenSequence flattened once into a schedule of tracks sorted by start time
+// Playing it advances a cursor over the schedule instead of starting chained sequences
+// std::shared_ptr<const TweenSequence<float>> intro = tweens.MakeSequence();
+// TweenTimeline<float> cutscene(intro);
+// cutscene.Update(deltaTime);
+// cutscene.Seek(12.5); // random access, no callbacks
+// Callbacks are borrowed from the sequences, which the timeline keeps alive
+// *Groups are ignored, every track plays once even if looping, and values are computed with the exact curves
+template <class T, class Alloc>
+class TweenTimeline
+{
+public:
+	explicit TweenTimeline(const std::shared_ptr<const TweenSequence<T, Alloc>>& sequence, const Alloc& alloc = Alloc());
+
+	// Advances playback: writes the tracks running at the new time
+	// and calls their step callbacks, then snaps and calls the finish callbacks of the ones that ended
+	void Update(float deltaTime);
+	// Jumps to 'time' seconds from the start and writes every track started by then,
+	// later tracks overriding earlier ones on the same target
+	// *Callbacks are not called
+	void Seek(double time);
+	// Starts over once the last track ended
+	// *Optional, disabled by default
+	void SetLooping(bool looping);
+	double GetTime() const;
+	// Time at which the last track ends
+	double GetDuration() const;
+	// Number of tracks, one per tween activation of the chain graph
+	size_t Size() const;
+	// All tracks ended and the timeline does not loop
+	bool IsFinished() const;
+
+private:
+	typedef typename Detail::DeltaOf<T>::type Delta;
+	typedef STween<T, Alloc> Tweens;
+
+	// Track of the schedule before sorting
+	struct Activation
+	{
+		double start;
+		const TweenSequence<T, Alloc>* sequence;
+		size_t index;
+	};
+
+	// Progress of track i at time 'time'
+	float ProgressAt(size_t i, double time) const;
+	// Writes the value of track i at 'progress' to its target, returns it
+	T WriteTrack(size_t i, float progress) const;
+	// Starts the tracks due by m_time, then writes and calls back the running ones
+	void PlayTracks();
+
+	// Sorted by start time
+	TweenVector<double, Alloc> m_startTime;
+	// Progress the track has when it starts, from the elapsed time of its tween
+	TweenVector<float, Alloc> m_offset;
+	TweenVector<float, Alloc> m_invDuration;
+	TweenVector<T, Alloc> m_base;
+	TweenVector<Delta, Alloc> m_delta;
+	TweenVector<T, Alloc> m_final;
+	TweenVector<EasingFunction, Alloc> m_easing;
+	TweenVector<T*, Alloc> m_target;
+	TweenVector<const TweenCallbacks<T, Alloc>*, Alloc> m_callbacks;
+	// Every sequence of the graph, keeps the borrowed callbacks alive
+	TweenVector<std::shared_ptr<const TweenSequence<T, Alloc>>, Alloc> m_sequences;
+
+	double m_time;
+	double m_duration;
+	bool m_looping;
+	// First track not started yet
+	size_t m_cursor;
+	// Started tracks still running, in start order
+	TweenVector<size_t, Alloc> m_active;
+};
+
+template<class T, class Alloc>TweenTimeline<T, Alloc>::TweenTimeline(const std::shared_ptr<const TweenSequence<T, Alloc>>& sequence, const Alloc& alloc)
+	:m_startTime(alloc),
+	m_offset(alloc),
+	m_invDuration(alloc),
+	m_base(alloc),
+	m_delta(alloc),
+	m_final(alloc),
+	m_easing(alloc),
+	m_target(alloc),
+	m_callbacks(alloc),
+	m_sequences(alloc),
+	m_time(0),
+	m_duration(0),
+	m_looping(false),
+	m_cursor(0),
+	m_active(alloc)
+{
+	// Walks the graph breadth first: a sequence chained by a tween starts once that tween ends
+	TweenVector<Activation, Alloc> activations(alloc);
+	TweenVector<std::pair<const TweenSequence<T, Alloc>*, double>, Alloc> pending(alloc);
+	if (sequence)
+	{
+		m_sequences.push_back(sequence);
+		pending.push_back(std::make_pair(sequence.get(), 0.0));
+	}
+
+	for (size_t p = 0; p < pending.size(); ++p)
+	{
+		const TweenSequence<T, Alloc>& tweens = *pending[p].first;
+		const double base = pending[p].second;
+		for (size_t k = 0; k < tweens.flags.size(); ++k)
+		{
+			const double start = base + ((tweens.flags[k] & Tweens::FlagDelayed) ? tweens.delay[k] : 0.0f);
+			const Activation activation = { start, &tweens, k };
+			activations.push_back(activation);
+
+			const double duration = tweens.duration[k] > 0 ? tweens.duration[k] - tweens.timeCounter[k] : 0.0;
+			const double end = start + (duration > 0 ? duration : 0.0);
+			m_duration = std::max(m_duration, end);
+
+			const std::shared_ptr<const TweenSequence<T, Alloc>>& chain = tweens.callbacks[k].endTween;
+			if ((tweens.flags[k] & Tweens::FlagChain) && chain)
+			{
+				m_sequences.push_back(chain);
+				pending.push_back(std::make_pair(chain.get(), end));
+			}
+		}
+	}
+
+	// Ties keep the order the tweens would have started in
+	std::stable_sort(activations.begin(), activations.end(), [](const Activation& a, const Activation& b) { return a.start < b.start; });
+
+	const size_t count = activations.size();
+	m_startTime.reserve(count);
+	m_offset.reserve(count);
+	m_invDuration.reserve(count);
+	m_base.reserve(count);
+	m_delta.reserve(count);
+	m_final.reserve(count);
+	m_easing.reserve(count);
+	m_target.reserve(count);
+	m_callbacks.reserve(count);
+	m_active.reserve(count);
+	for (size_t n = 0; n < count; ++n)
+	{
+		const TweenSequence<T, Alloc>& tweens = *activations[n].sequence;
+		const size_t k = activations[n].index;
+		const bool reversed = (tweens.flags[k] & Tweens::FlagReversed) != 0;
+		const float duration = tweens.duration[k];
+
+		m_startTime.push_back(activations[n].start);
+		m_invDuration.push_back(duration > 0 ? 1.0f / duration : 0.0f);
+		m_offset.push_back(duration > 0 ? tweens.timeCounter[k] / duration : 1.0f);
+		m_base.emplace_back();
+		m_delta.emplace_back();
+		Detail::Lanes<T>::Resolve(reversed ? tweens.end[k] : tweens.start[k], reversed ? tweens.start[k] : tweens.end[k], m_base.back(), m_delta.back());
+		m_final.push_back(reversed ? tweens.start[k] : tweens.end[k]);
+		m_easing.push_back(tweens.easing[k]);
+		m_target.push_back(tweens.target[k]);
+		m_callbacks.push_back(&tweens.callbacks[k]);
+	}
+}
+
+template<class T, class Alloc>float TweenTimeline<T, Alloc>::ProgressAt(size_t i, double time) const
+{
+	if (m_invDuration[i] <= 0)
+	{
+		return 1.0f;
+	}
+
+	return static_cast<float>((time - m_startTime[i]) * m_invDuration[i]) + m_offset[i];
+}
+
+template<class T, class Alloc>T TweenTimeline<T, Alloc>::WriteTrack(size_t i, float progress) const
+{
+	const T value = progress >= 1.0f ? m_final[i] : Detail::Lanes<T>::Evaluate(m_base[i], m_delta[i], Detail::Ease(m_easing[i], progress > 0 ? progress : 0.0f));
+	if (m_target[i])
+	{
+		*m_target[i] = value;
+	}
+
+	return value;
+}
+
+template<class T, class Alloc> void TweenTimeline<T, Alloc>::Update(float deltaTime)
+{
+	m_time += deltaTime;
+	PlayTracks();
+
+	// The next cycle starts with the time past the end,
+	// tracks due within it start in this call so cycles don't drift by a frame
+	while (m_looping && m_cursor == m_startTime.size() && m_active.empty() && m_duration > 0 && m_time >= m_duration)
+	{
+		m_time -= m_duration;
+		m_cursor = 0;
+		PlayTracks();
+	}
+}
+
+template<class T, class Alloc> void TweenTimeline<T, Alloc>::PlayTracks()
+{
+	// Tracks starting by now join the running ones
+	const size_t count = m_startTime.size();
+	while (m_cursor < count && m_startTime[m_cursor] <= m_time)
+	{
+		m_active.push_back(m_cursor++);
+	}
+
+	size_t running = 0;
+	for (size_t k = 0; k < m_active.size(); ++k)
+	{
+		const size_t i = m_active[k];
+		const float progress = ProgressAt(i, m_time);
+		T value = WriteTrack(i, progress);
+
+		const TweenCallbacks<T, Alloc>& callbacks = *m_callbacks[i];
+		if (progress >= 1.0f)
+		{
+			if (callbacks.finishCallback)
+			{
+				callbacks.finishCallback();
+			}
+			continue;
+		}
+
+		if (callbacks.stepCallback)
+		{
+			callbacks.stepCallback(value);
+		}
+		m_active[running++] = i;
+	}
+	m_active.resize(running);
+}
+
+template<class T, class Alloc> void TweenTimeline<T, Alloc>::Seek(double time)
+{
+	m_time = time;
+	m_cursor = static_cast<size_t>(std::upper_bound(m_startTime.begin(), m_startTime.end(), time) - m_startTime.begin());
+	m_active.clear();
+
+	for (size_t i = 0; i < m_cursor; ++i)
+	{
+		const float progress = ProgressAt(i, time);
+		WriteTrack(i, progress);
+		if (progress < 1.0f)
+		{
+			m_active.push_back(i);
+		}
+	}
+}
+
+template<class T, class Alloc> void TweenTimeline<T, Alloc>::SetLooping(bool looping)
+{
+	m_looping = looping;
+}
+
+template<class T, class Alloc>double TweenTimeline<T, Alloc>::GetTime() const
+{
+	return m_time;
+}
+
+template<class T, class Alloc>double TweenTimeline<T, Alloc>::GetDuration() const
+{
+	return m_duration;
+}
+
+template<class T, class Alloc>size_t TweenTimeline<T, Alloc>::Size() const
+{
+	return m_startTime.size();
+}
+
+template<class T, class Alloc>bool TweenTimeline<T, Alloc>::IsFinished() const
+{
+	return !m_looping && m_cursor == m_startTime.size() && m_active.empty();
+}
+
+// Group of tweens sharing an easing function known at compile time
+// The curve is inlined into Update() and evaluated in SIMD lanes,
+// so a group is cheaper per tween than STween with a runtime Easing()
+// StaticTweenGroup<float, CubicOut> fades;
+// fades.From(&alpha).To(0.0f).Time(0.3f);
+// *Same builder as STween, without chains, handles or Easing()
+template <class T, EasingFunction E, class Alloc = std::allocator<T>>
+class StaticTweenGroup
+{
+public:
+	explicit StaticTweenGroup(const Alloc& alloc = Alloc());
+
+	// Creates a Tween starting from the initial value given
+	// Also sets the value each frame to the variable it points to
+	// *Only use when the object pointing to is guaranteed to be alive
+	// *Must-to-call
+	StaticTweenGroup& From(T* initVal);
+	// Creates a Tween starting from the initial value given
+	// A setter callback for the value needs to be set with OnStep()
+	// *Must-to-call
+	StaticTweenGroup& From(T initVal);
+	// Sets the desired final value
+	// *Must-to-call
+	StaticTweenGroup& To(T finalVal);
 	// Sets the duration of the tween
 	// *Must-to-call
-	STween& Time(float sec);
+	StaticTweenGroup& Time(float sec);
 	// Sets a callback once the tween is finished
 	// *Optional
-	STween& OnFinish(std::function<void()> endCallback);
+	template<class Callback> StaticTweenGroup& OnFinish(Callback endCallback);
 	// Sets a callback for each frame the value is changing
-	// Use this method as a setter if From() argument is const
-	// *Optional
-	STween& OnStep(std::function<void(T&)> callabck);
-	// Chains another tween after this one ends
 	// *Optional
-	STween& Chain(STween<T>* chain);
+	template<class Callback> StaticTweenGroup& OnStep(Callback callback);
 	// Reverses the current tween
-	// Values will be tweened from the final value to the initial value if set to true
-	// Useful when creating a 'Loop' tween
 	// *Optional
-	STween& Reversed(bool isReversed);
-	// Sets the easing function
+	StaticTweenGroup& Reversed(bool isReversed);
+	// Processes every running tween
+	// Callbacks may create tweens on this group, those start on the next Update()
+	void Update(float deltaTime);
+	// Number of tweens registered
+	size_t Size() const;
+	// Resets the group
+	void ReleaseTweens();
+	// Same as STween::AddBatch()
+	void AddBatch(TweenSpan<T* const> targets, TweenSpan<const T> finals, float duration);
+	// Same as STween::Reserve()
+	void Reserve(size_t count);
+
+private:
+	enum TweenFlag : unsigned char
+	{
+		FlagReversed = 1 << 0,
+		FlagFinishCallback = 1 << 1,
+		FlagStepCallback = 1 << 2
+	};
+
+	typedef typename Detail::DeltaOf<T>::type Delta;
+
+	void PushTween(T* target, const T& initVal);
+	void MoveTween(size_t from, size_t to);
+	void TruncateTweens(size_t count);
+	template<class Visitor> void ForEachColumn(Visitor& visitor);
+	void ResolveValues(size_t index);
+
+	// Normalized position and 1 / duration, as in STween
+	TweenVector<float, Alloc> m_progress;
+	TweenVector<float, Alloc> m_invDuration;
+	TweenVector<T, Alloc> m_base;
+	TweenVector<Delta, Alloc> m_delta;
+	// Start and end are kept already swapped for reversed tweens
+	TweenVector<T, Alloc> m_start;
+	TweenVector<T, Alloc> m_end;
+	TweenVector<T*, Alloc> m_target;
+	TweenVector<unsigned char, Alloc> m_flags;
+	TweenVector<TweenFunction<void()>, Alloc> m_finishCallback;
+	TweenVector<TweenFunction<void(T&)>, Alloc> m_stepCallback;
+	// Scratch buffer holding positions then eased factors
+	TweenVector<float, Alloc> m_eased;
+};
+
+template<class T, EasingFunction E, class Alloc>StaticTweenGroup<T, E, Alloc>::StaticTweenGroup(const Alloc& alloc)
+	:m_progress(alloc),
+	m_invDuration(alloc),
+	m_base(alloc),
+	m_delta(alloc),
+	m_start(alloc),
+	m_end(alloc),
+	m_target(alloc),
+	m_flags(alloc),
+	m_finishCallback(alloc),
+	m_stepCallback(alloc),
+	m_eased(alloc)
+{}
+
+template<class T, EasingFunction E, class Alloc> void StaticTweenGroup<T, E, Alloc>::PushTween(T* target, const T& initVal)
+{
+	Detail::ColumnPush push;
+	ForEachColumn(push);
+
+	const size_t last = m_flags.size() - 1;
+	// No duration yet, finishes on the next Update()
+	m_progress[last] = 1.0f;
+	m_invDuration[last] = 0;
+	m_start[last] = initVal;
+	m_end[last] = initVal;
+	m_target[last] = target;
+	m_flags[last] = 0;
+	ResolveValues(last);
+}
+
+template<class T, EasingFunction E, class Alloc> void StaticTweenGroup<T, E, Alloc>::MoveTween(size_t from, size_t to)
+{
+	Detail::ColumnMove move = { from, to };
+	ForEachColumn(move);
+}
+
+template<class T, EasingFunction E, class Alloc> void StaticTweenGroup<T, E, Alloc>::TruncateTweens(size_t count)
+{
+	Detail::ColumnTruncate truncate = { count };
+	ForEachColumn(truncate);
+}
+
+template<class T, EasingFunction E, class Alloc> template<class Visitor> void StaticTweenGroup<T, E, Alloc>::ForEachColumn(Visitor& visitor)
+{
+	visitor(m_progress);
+	visitor(m_invDuration);
+	visitor(m_base);
+	visitor(m_delta);
+	visitor(m_start);
+	visitor(m_end);
+	visitor(m_target);
+	visitor(m_flags);
+	visitor(m_finishCallback);
+	visitor(m_stepCallback);
+}
+
+template<class T, EasingFunction E, class Alloc> void StaticTweenGroup<T, E, Alloc>::ResolveValues(size_t index)
+{
+	Detail::Lanes<T>::Resolve(m_start[index], m_end[index], m_base[index], m_delta[index]);
+}
+
+template<class T, EasingFunction E, class Alloc>StaticTweenGroup<T, E, Alloc>& StaticTweenGroup<T, E, Alloc>::From(T* initVal)
+{
+	PushTween(initVal, *initVal);
+
+	return *this;
+}
+
+template<class T, EasingFunction E, class Alloc>StaticTweenGroup<T, E, Alloc>& StaticTweenGroup<T, E, Alloc>::From(T initVal)
+{
+	PushTween(nullptr, initVal);
+
+	return *this;
+}
+
+template<class T, EasingFunction E, class Alloc>StaticTweenGroup<T, E, Alloc>& StaticTweenGroup<T, E, Alloc>::To(T finalVal)
+{
+	const size_t last = m_flags.size() - 1;
+	if (m_flags[last] & FlagReversed)
+		m_start[last] = finalVal;
+	else
+		m_end[last] = finalVal;
+	ResolveValues(last);
+
+	return *this;
+}
+
+template<class T, EasingFunction E, class Alloc>StaticTweenGroup<T, E, Alloc>& StaticTweenGroup<T, E, Alloc>::Time(float sec)
+{
+	if (sec > 0)
+	{
+		m_invDuration.back() = 1.0f / sec;
+		m_progress.back() = 0;
+	}
+	else
+	{
+		m_invDuration.back() = 0;
+		m_progress.back() = 1.0f;
+	}
+
+	return *this;
+}
+
+template<class T, EasingFunction E, class Alloc> template<class Callback> StaticTweenGroup<T, E, Alloc>& StaticTweenGroup<T, E, Alloc>::OnFinish(Callback endCallback)
+{
+	m_finishCallback.back() = TweenFunction<void()>(std::allocator_arg, m_finishCallback.get_allocator(), std::move(endCallback));
+	if (m_finishCallback.back())
+		m_flags.back() |= FlagFinishCallback;
+	else
+		m_flags.back() &= ~FlagFinishCallback;
+
+	return *this;
+}
+
+template<class T, EasingFunction E, class Alloc> template<class Callback> StaticTweenGroup<T, E, Alloc>& StaticTweenGroup<T, E, Alloc>::OnStep(Callback callback)
+{
+	m_stepCallback.back() = TweenFunction<void(T&)>(std::allocator_arg, m_stepCallback.get_allocator(), std::move(callback));
+	if (m_stepCallback.back())
+		m_flags.back() |= FlagStepCallback;
+	else
+		m_flags.back() &= ~FlagStepCallback;
+
+	return *this;
+}
+
+template<class T, EasingFunction E, class Alloc>StaticTweenGroup<T, E, Alloc>& StaticTweenGroup<T, E, Alloc>::Reversed(bool isReversed)
+{
+	const size_t last = m_flags.size() - 1;
+	if (isReversed != ((m_flags[last] & FlagReversed) != 0))
+	{
+		std::swap(m_start[last], m_end[last]);
+		m_flags[last] ^= FlagReversed;
+		ResolveValues(last);
+	}
+
+	return *this;
+}
+
+template<class T, EasingFunction E, class Alloc> void StaticTweenGroup<T, E, Alloc>::Update(float deltaTime)
+{
+	const size_t count = m_flags.size();
+	if (count == 0)
+	{
+		return;
+	}
+	m_eased.resize(count);
+
+	// Straight-line passes the compiler can vectorize:
+	// positions first, then the curve over all of them
+	float* eased = m_eased.data();
+	std::copy(m_progress.begin(), m_progress.begin() + count, eased);
+
+	Detail::EaseRange<Detail::CurveFor<E>::template Curve>(eased, count);
+
+	size_t alive = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const unsigned char flags = m_flags[i];
+		const float progress = m_progress[i];
+		T value = Detail::Lanes<T>::Evaluate(m_base[i], m_delta[i], eased[i]);
+
+		T* target = m_target[i];
+		if (target)
+		{
+			*target = value;
+		}
+
+		// Callbacks run from locals, tweens they create may grow the callback arrays
+		if (flags & FlagStepCallback)
+		{
+			TweenFunction<void(T&)> callback(std::move(m_stepCallback[i]));
+			callback(value);
+			if (!m_stepCallback[i])
+			{
+				m_stepCallback[i] = std::move(callback);
+			}
+		}
+
+		if (progress >= 1.0f)
+		{
+			if (target)
+			{
+				*target = m_end[i];
+			}
+
+			if (flags & FlagFinishCallback)
+			{
+				const TweenFunction<void()> callback(std::move(m_finishCallback[i]));
+				callback();
+			}
+
+			continue;
+		}
+
+		m_progress[i] = progress + deltaTime * m_invDuration[i];
+
+		if (alive != i)
+		{
+			MoveTween(i, alive);
+		}
+		++alive;
+	}
+
+	// Tweens created by callbacks during the loop
+	for (size_t i = count; i < m_flags.size(); ++i, ++alive)
+	{
+		MoveTween(i, alive);
+	}
+
+	TruncateTweens(alive);
+}
+
+template<class T, EasingFunction E, class Alloc>size_t StaticTweenGroup<T, E, Alloc>::Size() const
+{
+	return m_flags.size();
+}
+
+template<class T, EasingFunction E, class Alloc> void StaticTweenGroup<T, E, Alloc>::ReleaseTweens()
+{
+	TruncateTweens(0);
+}
+
+template<class T, EasingFunction E, class Alloc> void StaticTweenGroup<T, E, Alloc>::AddBatch(TweenSpan<T* const> targets, TweenSpan<const T> finals, float duration)
+{
+	const size_t count = std::min(targets.size(), finals.size());
+	const size_t needed = m_flags.size() + count;
+	if (needed > m_flags.capacity())
+	{
+		Reserve(std::max(needed, 2 * m_flags.capacity()));
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (targets[i])
+			From(targets[i]);
+		else
+			From(finals[i]);
+		To(finals[i]).Time(duration);
+	}
+}
+
+template<class T, EasingFunction E, class Alloc> void StaticTweenGroup<T, E, Alloc>::Reserve(size_t count)
+{
+	Detail::ColumnReserve reserve = { count };
+	ForEachColumn(reserve);
+	m_eased.reserve(count);
+}
+
+// Group of tweens stored in as few bytes as possible, for large amounts of simple tweens
+// Each tween keeps its target, end, end - start and 1 / duration, plus one 32-bit word
+// packing its progress as 24-bit fixed point with a byte of easing and state flags:
+// 24 bytes for a float tween on a 64-bit machine, against well over 100 in STween
+// Callbacks, chains and easing functions past the first 31 live in a sparse side table,
+// only tweens using them have an entry
+// Update() eases the tweens by chunks, sorted by easing function as STween::SetBatchedEasing() does
+// CompactTweenGroup<float> sparkles;
+// sparkles.From(&alpha).To(0.0f).Time(0.3f).Easing(QuadranticOut);
+// *Same builder as STween, without handles, delays, groups nor loops
+// *Progress advances in steps of 1 / 2^24, timing drifts by less than 0.1% for tweens up to 10 minutes at 60 FPS
+template <class T, class Alloc>
+class CompactTweenGroup
+{
+public:
+	explicit CompactTweenGroup(const Alloc& alloc = Alloc());
+
+	// Creates a Tween starting from the initial value given
+	// Also sets the value each frame to the variable it points to
+	// *Only use when the object pointing to is guaranteed to be alive
+	// *Must-to-call
+	CompactTweenGroup& From(T* initVal);
+	// Creates a Tween starting from the initial value given
+	// A setter callback for the value needs to be set with OnStep()
+	// *Must-to-call
+	CompactTweenGroup& From(T initVal);
+	// Sets the desired final value
+	// *Must-to-call
+	CompactTweenGroup& To(T finalVal);
+	// Sets the duration of the tween
+	// *Must-to-call
+	CompactTweenGroup& Time(float sec);
+	// Sets the easing function, built-in or returned by RegisterEasing()
 	// Linear is set by default
 	// *Optional
-	STween& Easing(EasingFunction easingType);
-	// Returns all the tweens registered
-	// Helper function in case it is needed
-	// Normally used with AddTweens()
-	// a.AddTweens(b.GetTweens());
-	std::vector<TweenData<T>> GetTweens();
-	// Resets the STween object
-	void ReleaseTweens();
-	// Adds all the tweens from the container
-	// Helper function in case it is needed
-	// Normally used with GetTweens()
-	// a.AddTweens(b.GetTweens());
-	void AddTweens(std::vector<TweenData<T>> tweens);
+	CompactTweenGroup& Easing(EasingFunction easingType);
+	// Sets a callback once the tween is finished
+	// *Optional
+	template<class Callback> CompactTweenGroup& OnFinish(Callback endCallback);
+	// Sets a callback for each frame the value is changing
+	// *Optional
+	template<class Callback> CompactTweenGroup& OnStep(Callback callback);
+	// Chains a sequence after this one ends, see STween::MakeSequence()
+	// *Delays, groups and loops of the sequence are ignored
+	// *Optional
+	CompactTweenGroup& Chain(std::shared_ptr<const TweenSequence<T, Alloc>> sequence);
+	// Reverses the current tween
+	// *Optional
+	CompactTweenGroup& Reversed(bool isReversed);
 	// Processes every running tween
-	// deltaTime used for frame-rate independent tweening
+	// Callbacks may create tweens on this group, those start on the next Update()
 	void Update(float deltaTime);
-	// Adds a single TweenData
-	// Helper function in case it is needed
-	void AddTween(TweenData<T> STween);
+	// Number of tweens registered
+	size_t Size() const;
+	// Resets the group
+	void ReleaseTweens();
+	// Same as STween::AddBatch()
+	void AddBatch(TweenSpan<T* const> targets, TweenSpan<const T> finals, float duration, EasingFunction easing = Linear);
+	// Same as STween::Reserve(), the side table grows on its own
+	void Reserve(size_t count);
+
 private:
-	T Linear(float position, T start, T end);
-	T QuadIn(float position, T start, T end);
-	T QuadOut(float position, T start, T end);
-	T QuadInOut(float position, T start, T end);
-	T CubicIn(float position, T start, T end);
-	T CubicOut(float position, T start, T end);
-	T CubicInOut(float position, T start, T end);
-	T QuintIn(float position, T start, T end);
-	T QuintOut(float position, T start, T end);
-	T QuintInOut(float position, T start, T end);
-	T BackIn(float position, T start, T end);
-	T BackOut(float position, T start, T end);
-	T BackInOut(float position, T start, T end);
+	typedef typename Detail::DeltaOf<T>::type Delta;
+
+	// Low byte of m_state, the easing function takes the low 5 bits
+	enum TweenFlag : unsigned int
+	{
+		EasingMask = (1 << 5) - 1,
+		FlagReversed = 1 << 5,
+		FlagSide = 1 << 6
+	};
+
+	// Easing value meaning the easing function is in the side table
+	static const unsigned int SideEasing = EasingMask;
+	// Progress of finished tweens, the high 24 bits of m_state
+	static const unsigned int ProgressDone = (1u << 24) - 1;
+	// Tweens eased at once by Update(), its buffers live on the stack
+	static const size_t ChunkSize = 256;
+
+	// Side table entry, ordered by tween index like the arrays
+	// Tweens started by a chain borrow the callbacks stored in the sequence
+	struct Side
+	{
+		Side()
+			:index(0),
+			easing(Linear),
+			sourceIndex(0)
+		{}
 
-private:
-	int m_lastTweenIndex;
-	std::vector<TweenData<T>> m_tweenVec;
-};
+		unsigned int index;
+		EasingFunction easing;
+		TweenCallbacks<T, Alloc> callbacks;
+		std::shared_ptr<const TweenSequence<T, Alloc>> source;
+		unsigned int sourceIndex;
+	};
 
-template<class T>STween<T>::STween()
-	:m_lastTweenIndex(-1)
-{}
+	void PushTween(T* target, const T& initVal);
+	void MoveTween(size_t from, size_t to);
+	void TruncateTweens(size_t count);
+	template<class Visitor> void ForEachColumn(Visitor& visitor);
+	// Stores the value at progress 0 and 1 of the last tween
+	void SetEndpoints(const T& from, const T& to);
+	// Sets the normalized progress of the tween at index, 1 or more once finished
+	void SetProgress(size_t index, float progress);
+	void SetEasing(size_t index, EasingFunction easing);
+	// Writes the eased progress of 'count' tweens from 'first' to 'eased'
+	// 'side' is the side entry of the first tween or of the next one having any
+	void EaseChunk(size_t first, size_t count, size_t side, float* eased) const;
+	// Returns the side entry of the last tween, added if it has none
+	Side& LastSide();
+	const TweenCallbacks<T, Alloc>& CallbacksOf(const Side& side) const;
+	// Call the callbacks of the side entry from locals, so the tweens they create may grow m_side
+	void RunStepCallback(size_t side, T& value);
+	void RunFinishCallback(size_t side);
+	void StartSequence(const std::shared_ptr<const TweenSequence<T, Alloc>>& sequence);
 
-template<class T>STween<T>::~STween()
+	// Hot data, the whole tween
+	TweenVector<T*, Alloc> m_target;
+	// Value at progress 1 and its distance from the one at progress 0, swapped for reversed tweens
+	// Values are end + delta * (eased - 1), so finished tweens land exactly on the end
+	TweenVector<T, Alloc> m_end;
+	TweenVector<Delta, Alloc> m_delta;
+	TweenVector<float, Alloc> m_invDuration;
+	// Progress << 8 | flags
+	TweenVector<unsigned int, Alloc> m_state;
+	TweenVector<Side, Alloc> m_side;
+	// Value at progress 0 of the last tween, so To() and Reversed() don't derive it back from the delta
+	T m_lastFrom;
+};
+
+template<class T, class Alloc>CompactTweenGroup<T, Alloc>::CompactTweenGroup(const Alloc& alloc)
+	:m_target(alloc),
+	m_end(alloc),
+	m_delta(alloc),
+	m_invDuration(alloc),
+	m_state(alloc),
+	m_side(alloc),
+	m_lastFrom()
 {}
 
-template<class T> void STween<T>::ReleaseTweens()
+template<class T, class Alloc> void CompactTweenGroup<T, Alloc>::PushTween(T* target, const T& initVal)
 {
-	m_tweenVec.clear();
-	m_lastTweenIndex = -1;
+	Detail::ColumnPush push;
+	ForEachColumn(push);
+
+	const size_t last = m_state.size() - 1;
+	m_target[last] = target;
+	SetEndpoints(initVal, initVal);
+	// No duration yet, finishes on the next Update()
+	m_invDuration[last] = 0;
+	m_state[last] = ProgressDone << 8 | static_cast<unsigned int>(Linear);
 }
 
-template<class T>STween<T>& STween<T>::From(T* initVal)
+template<class T, class Alloc> void CompactTweenGroup<T, Alloc>::MoveTween(size_t from, size_t to)
 {
-	TweenData<T> tween(m_lastTweenIndex);
-	tween.fromReady = true;
-	tween.byPointer = true;
-	tween.initialValue = initVal;
-	tween.initialCpy = *initVal;
-	tween.duration = 0;
-	tween.timeCounter = 0;
-	tween.endTween = std::vector<TweenData<T>>();
-
-	m_tweenVec.push_back(tween);
-
-	m_lastTweenIndex++;
-
-	return *this;
+	Detail::ColumnMove move = { from, to };
+	ForEachColumn(move);
 }
 
-template<class T>STween<T>& STween<T>::From(T initVal)
+template<class T, class Alloc> void CompactTweenGroup<T, Alloc>::TruncateTweens(size_t count)
 {
-	TweenData<T> tween(m_lastTweenIndex);
-
-	tween.fromReady = true;
-	tween.byPointer = false;
-	tween.initialValue = nullptr;
-	tween.initialCpy = initVal;
-	tween.duration = 0;
-	tween.timeCounter = 0;
-	tween.endTween = std::vector<TweenData<T>>();
-
-	m_tweenVec.push_back(tween);
-
-	m_lastTweenIndex++;
-
-	return *this;
+	Detail::ColumnTruncate truncate = { count };
+	ForEachColumn(truncate);
 }
 
-template<class T>STween<T>& STween<T>::To(T finalVal)
+template<class T, class Alloc> template<class Visitor> void CompactTweenGroup<T, Alloc>::ForEachColumn(Visitor& visitor)
 {
-	m_tweenVec[m_lastTweenIndex].finalValue = finalVal;
-
-	return *this;
+	visitor(m_target);
+	visitor(m_end);
+	visitor(m_delta);
+	visitor(m_invDuration);
+	visitor(m_state);
 }
 
-template<class T>STween<T>& STween<T>::Time(float sec)
+template<class T, class Alloc> void CompactTweenGroup<T, Alloc>::SetEndpoints(const T& from, const T& to)
 {
-	m_tweenVec[m_lastTweenIndex].duration = sec;
+	const size_t last = m_state.size() - 1;
+	T base;
+	Detail::Lanes<T>::Resolve(from, to, base, m_delta[last]);
+	m_end[last] = to;
+	m_lastFrom = from;
+}
 
-	return *this;
+template<class T, class Alloc> void CompactTweenGroup<T, Alloc>::SetProgress(size_t index, float progress)
+{
+	unsigned int fixed = ProgressDone;
+	if (progress < 1.0f)
+	{
+		fixed = progress > 0 ? static_cast<unsigned int>(progress * ProgressDone + 0.5f) : 0;
+	}
+	m_state[index] = fixed << 8 | (m_state[index] & 0xFF);
 }
 
-template<class T> void STween<T>::Update(float deltaTime)
+template<class T, class Alloc> void CompactTweenGroup<T, Alloc>::SetEasing(size_t index, EasingFunction easing)
 {
-	std::vector<TweenData<T>> tweensToAdd;
-	std::vector<int> tweensToDelete;
-	
-	int counter = 0;
-	for (auto &tween : m_tweenVec)
+	unsigned int code = static_cast<unsigned int>(easing);
+	if (code >= SideEasing)
 	{
-		if (tween.fromReady)
-		{
-			float timePos = tween.timeCounter / tween.duration;
+		LastSide().easing = easing;
+		code = SideEasing;
+	}
+	m_state[index] = (m_state[index] & ~static_cast<unsigned int>(EasingMask)) | code;
+}
+
+template<class T, class Alloc> void CompactTweenGroup<T, Alloc>::EaseChunk(size_t first, size_t count, size_t side, float* eased) const
+{
+	const float toProgress = 1.0f / ProgressDone;
+	const unsigned int* state = m_state.data() + first;
 
-			T value, start, end;
+	// Easing functions in the side table are evaluated one by one
+	size_t runs = 0;
+	unsigned int previous = SideEasing;
+	for (size_t k = 0; k < count; ++k)
+	{
+		const unsigned int code = state[k] & EasingMask;
+		eased[k] = (state[k] >> 8) * toProgress;
+		if (code == SideEasing)
+			eased[k] = Detail::Ease(m_side[side].easing, eased[k]);
+		runs += code != previous;
+		previous = code;
+		side += (state[k] & FlagSide) != 0;
+	}
 
-			if (tween.reversed)
+	// Tweens added together mostly share their easing function, those are eased in place run by run
+	if (runs * 8 <= count)
+	{
+		for (size_t k = 0; k < count;)
+		{
+			const unsigned int code = state[k] & EasingMask;
+			size_t next = k + 1;
+			while (next < count && (state[next] & EasingMask) == code)
 			{
-				start = tween.finalValue;
-				end = tween.initialCpy;
+				++next;
 			}
-			else
+			if (code != SideEasing)
 			{
-				start = tween.initialCpy;
-				end = tween.finalValue;
+				Detail::EaseBatch(static_cast<EasingFunction>(code), eased + k, next - k);
 			}
+			k = next;
+		}
+		return;
+	}
 
-			switch (tween.easing)
-			{
-			case EasingFunction::Linear:
-				value = Linear(timePos, start, end);
-				break;
-			case EasingFunction::QuadranticIn:
-				value = QuadIn(timePos, start, end);
-				break;
-
-			case EasingFunction::QuadranticOut:
-				value = QuadOut(timePos, start, end);
-				break;
-
-			case EasingFunction::QuadranticInOut:
-				value = QuadInOut(timePos, start, end);
-				break;
-
-			case EasingFunction::CubicIn:
-				value = CubicIn(timePos, start, end);
-				break;
-
-			case EasingFunction::CubicOut:
-				value = CubicOut(timePos, start, end);
-				break;
-
-			case EasingFunction::CubicInOut:
-				value = CubicInOut(timePos, start, end);
-				break;
-
-			case EasingFunction::QuintIn:
-				value = QuintIn(timePos, start, end);
-				break;
-
-			case EasingFunction::QuintOut:
-				value = QuintOut(timePos, start, end);
-				break;
-
-			case EasingFunction::QuintInOut:
-				value = QuintInOut(timePos, start, end);
-				break;
-
-			case EasingFunction::BackIn:
-				value = BackIn(timePos, start, end);
-				break;
+	// Otherwise counting sort by easing function
+	float sorted[ChunkSize];
+	unsigned short order[ChunkSize];
+	size_t bucketStart[SideEasing + 1] = {};
+	size_t bucketFill[SideEasing];
+	for (size_t k = 0; k < count; ++k)
+	{
+		const unsigned int code = state[k] & EasingMask;
+		bucketStart[code == SideEasing ? 0 : code + 1] += code != SideEasing;
+	}
 
-			case EasingFunction::BackOut:
-				value = BackOut(timePos, start, end);
-				break;
+	for (size_t e = 0; e < SideEasing; ++e)
+	{
+		bucketStart[e + 1] += bucketStart[e];
+		bucketFill[e] = bucketStart[e];
+	}
 
-			case EasingFunction::BackInOut:
-				value = BackInOut(timePos, start, end);
-				break;
+	for (size_t k = 0; k < count; ++k)
+	{
+		const unsigned int code = state[k] & EasingMask;
+		if (code != SideEasing)
+		{
+			const size_t slot = bucketFill[code]++;
+			order[slot] = static_cast<unsigned short>(k);
+			sorted[slot] = eased[k];
+		}
+	}
 
-			default:
-				value = Linear(timePos, start, end);
-				break;
-			}
+	for (size_t e = 0; e < SideEasing; ++e)
+	{
+		const size_t begin = bucketStart[e];
+		if (bucketStart[e + 1] > begin)
+		{
+			Detail::EaseBatch(static_cast<EasingFunction>(e), sorted + begin, bucketStart[e + 1] - begin);
+		}
+	}
 
-			if (tween.byPointer)
-			{
-				*tween.initialValue = value;
-			}
-				
-			if (tween.stepCallback)
-			{
-				tween.stepCallback(value);
-			}
-			tween.tweenID = counter;
-			if (tween.timeCounter >= tween.duration)
-			{
-				if (tween.byPointer)
-				{
-					*tween.initialValue = tween.reversed ? tween.initialCpy : tween.finalValue;
-				}
+	// Scatter the results back to tween order
+	for (size_t slot = 0; slot < bucketStart[SideEasing]; ++slot)
+	{
+		eased[order[slot]] = sorted[slot];
+	}
+}
 
-				tween.fromReady = false;
+template<class T, class Alloc>typename CompactTweenGroup<T, Alloc>::Side& CompactTweenGroup<T, Alloc>::LastSide()
+{
+	const size_t last = m_state.size() - 1;
+	if (!(m_state[last] & FlagSide))
+	{
+		m_side.emplace_back();
+		m_side.back().index = static_cast<unsigned int>(last);
+		m_state[last] |= FlagSide;
+	}
+	return m_side.back();
+}
 
-				tweensToDelete.push_back(counter);
+template<class T, class Alloc>const TweenCallbacks<T, Alloc>& CompactTweenGroup<T, Alloc>::CallbacksOf(const Side& side) const
+{
+	return side.source ? side.source->callbacks[side.sourceIndex] : side.callbacks;
+}
 
-				if (tween.finishCallback)
-				{
-					tween.finishCallback();
-				}
+template<class T, class Alloc> void CompactTweenGroup<T, Alloc>::RunStepCallback(size_t side, T& value)
+{
+	Side& entry = m_side[side];
+	if (entry.source)
+	{
+		const std::shared_ptr<const TweenSequence<T, Alloc>> source = entry.source;
+		const TweenFunction<void(T&)>& callback = source->callbacks[entry.sourceIndex].stepCallback;
+		if (callback)
+		{
+			callback(value);
+		}
+		return;
+	}
 
-				for (auto &callbackTw : tween.endTween)
-				{
-					auto endTween = callbackTw;
-					tweensToAdd.push_back(endTween);
-				}
-			}
+	if (!entry.callbacks.stepCallback)
+	{
+		return;
+	}
+	TweenFunction<void(T&)> callback(std::move(entry.callbacks.stepCallback));
+	callback(value);
+	if (!m_side[side].callbacks.stepCallback)
+	{
+		m_side[side].callbacks.stepCallback = std::move(callback);
+	}
+}
 
-			tween.timeCounter += deltaTime;
-		}
-		//fromReady == false (left overs)
-		else
+template<class T, class Alloc> void CompactTweenGroup<T, Alloc>::RunFinishCallback(size_t side)
+{
+	Side& entry = m_side[side];
+	if (entry.source)
+	{
+		const std::shared_ptr<const TweenSequence<T, Alloc>> source = entry.source;
+		const TweenFunction<void()>& callback = source->callbacks[entry.sourceIndex].finishCallback;
+		if (callback)
 		{
-			tweensToDelete.push_back(counter);
+			callback();
 		}
-
-		counter++;
+		return;
 	}
 
-	for (auto it = tweensToDelete.rbegin(); it != tweensToDelete.rend(); ++it)
+	const TweenFunction<void()> callback(std::move(entry.callbacks.finishCallback));
+	if (callback)
 	{
-		auto oldIt = m_tweenVec.begin() + *it;
-		*oldIt = std::move(m_tweenVec.back());
-		m_tweenVec.pop_back();
-		m_lastTweenIndex--;
+		callback();
 	}
+}
 
-	for (auto &newTween : tweensToAdd)
+template<class T, class Alloc> void CompactTweenGroup<T, Alloc>::StartSequence(const std::shared_ptr<const TweenSequence<T, Alloc>>& sequence)
+{
+	typedef STween<T, Alloc> Tweens;
+	const TweenSequence<T, Alloc>& tweens = *sequence;
+	for (size_t k = 0; k < tweens.flags.size(); ++k)
 	{
-		AddTween(newTween);
+		From(tweens.start[k]);
+		const size_t last = m_state.size() - 1;
+		m_target[last] = tweens.target[k];
+		To(tweens.end[k]).Time(tweens.duration[k]).Reversed((tweens.flags[k] & Tweens::FlagReversed) != 0);
+		if (tweens.duration[k] > 0)
+		{
+			SetProgress(last, tweens.timeCounter[k] / tweens.duration[k]);
+		}
+		if (tweens.flags[k] & (Tweens::FlagFinishCallback | Tweens::FlagStepCallback | Tweens::FlagChain))
+		{
+			Side& side = LastSide();
+			side.source = sequence;
+			side.sourceIndex = static_cast<unsigned int>(k);
+		}
+		SetEasing(last, tweens.easing[k]);
 	}
 }
 
-template<class T>STween<T>& STween<T>::OnFinish(std::function<void()> endCallback)
+template<class T, class Alloc>CompactTweenGroup<T, Alloc>& CompactTweenGroup<T, Alloc>::From(T* initVal)
+{
+	PushTween(initVal, *initVal);
+
+	return *this;
+}
+
+template<class T, class Alloc>CompactTweenGroup<T, Alloc>& CompactTweenGroup<T, Alloc>::From(T initVal)
 {
-	m_tweenVec[m_lastTweenIndex].finishCallback = endCallback;
+	PushTween(nullptr, initVal);
 
 	return *this;
 }
 
-template<class T>STween<T>& STween<T>::OnStep(std::function<void(T&)> callback)
+template<class T, class Alloc>CompactTweenGroup<T, Alloc>& CompactTweenGroup<T, Alloc>::To(T finalVal)
 {
+	const size_t last = m_state.size() - 1;
+	if (m_state[last] & FlagReversed)
+		SetEndpoints(finalVal, m_end[last]);
+	else
+		SetEndpoints(m_lastFrom, finalVal);
+
+	return *this;
+}
 
-	m_tweenVec[m_lastTweenIndex].stepCallback = callback;
+template<class T, class Alloc>CompactTweenGroup<T, Alloc>& CompactTweenGroup<T, Alloc>::Time(float sec)
+{
+	const size_t last = m_state.size() - 1;
+	m_invDuration[last] = sec > 0 ? 1.0f / sec : 0;
+	SetProgress(last, sec > 0 ? 0.0f : 1.0f);
 
 	return *this;
 }
 
-template<class T>STween<T>& STween<T>::Chain(STween<T>* chain)
+template<class T, class Alloc>CompactTweenGroup<T, Alloc>& CompactTweenGroup<T, Alloc>::Easing(EasingFunction easingType)
 {
-	m_tweenVec[m_lastTweenIndex].endTween = chain->GetTweens();
+	SetEasing(m_state.size() - 1, easingType);
 
 	return *this;
 }
 
-template<class T>STween<T>& STween<T>::Reversed(bool isReversed)
+template<class T, class Alloc> template<class Callback> CompactTweenGroup<T, Alloc>& CompactTweenGroup<T, Alloc>::OnFinish(Callback endCallback)
 {
-	m_tweenVec[m_lastTweenIndex].reversed = isReversed;
+	LastSide().callbacks.finishCallback = TweenFunction<void()>(std::allocator_arg, m_side.get_allocator(), std::move(endCallback));
 
 	return *this;
 }
 
-template<class T>STween<T>& STween<T>::Easing(EasingFunction easingType)
+template<class T, class Alloc> template<class Callback> CompactTweenGroup<T, Alloc>& CompactTweenGroup<T, Alloc>::OnStep(Callback callback)
 {
-	m_tweenVec[m_lastTweenIndex].easing = easingType;
+	LastSide().callbacks.stepCallback = TweenFunction<void(T&)>(std::allocator_arg, m_side.get_allocator(), std::move(callback));
 
 	return *this;
 }
 
-template<class T>std::vector<TweenData<T>> STween<T>::GetTweens()
+template<class T, class Alloc>CompactTweenGroup<T, Alloc>& CompactTweenGroup<T, Alloc>::Chain(std::shared_ptr<const TweenSequence<T, Alloc>> sequence)
 {
-	return m_tweenVec;
+	if (sequence && !sequence->flags.empty())
+	{
+		LastSide().callbacks.endTween = std::move(sequence);
+	}
+
+	return *this;
 }
 
-template<class T>void STween<T>::AddTween(TweenData<T> STween)
+template<class T, class Alloc>CompactTweenGroup<T, Alloc>& CompactTweenGroup<T, Alloc>::Reversed(bool isReversed)
 {
-	STween.tweenID = m_lastTweenIndex;
-	m_tweenVec.push_back(STween);
-	m_lastTweenIndex++;
+	const size_t last = m_state.size() - 1;
+	if (isReversed != ((m_state[last] & FlagReversed) != 0))
+	{
+		const T end = m_end[last];
+		SetEndpoints(end, m_lastFrom);
+		m_state[last] ^= FlagReversed;
+	}
+
+	return *this;
 }
 
-template<class T>void STween<T>::AddTweens(std::vector<TweenData<T>> tweens)
+template<class T, class Alloc> void CompactTweenGroup<T, Alloc>::Update(float deltaTime)
 {
-	for (auto &STween : tweens)
+	const size_t count = m_state.size();
+	if (count == 0)
 	{
-		AddTween(STween);
+		return;
+	}
+
+	// Progress is counted in 24-bit fixed point
+	const float scale = deltaTime * ProgressDone;
+	const size_t sideCount = m_side.size();
+	size_t side = 0;
+	size_t sideAlive = 0;
+	size_t alive = 0;
+	float eased[ChunkSize];
+	for (size_t i = 0; i < count; ++i)
+	{
+		// Tweens past i weren't moved yet, nor their side entries past 'side'
+		const size_t lane = i % ChunkSize;
+		if (lane == 0)
+		{
+			EaseChunk(i, count - i < ChunkSize ? count - i : ChunkSize, side, eased);
+		}
+
+		const unsigned int state = m_state[i];
+		const unsigned int progress = state >> 8;
+		// Callbacks may append entries, so the side table is only accessed by index
+		const bool hasSide = (state & FlagSide) != 0;
+
+		T value = Detail::Lanes<T>::Evaluate(m_end[i], m_delta[i], eased[lane] - 1.0f);
+
+		T* target = m_target[i];
+		if (target)
+		{
+			*target = value;
+		}
+
+		if (hasSide)
+		{
+			RunStepCallback(side, value);
+		}
+
+		if (progress >= ProgressDone)
+		{
+			if (target)
+			{
+				*target = m_end[i];
+			}
+
+			if (hasSide)
+			{
+				RunFinishCallback(side);
+				// Copied on purpose: starting the sequence grows the side table
+				const std::shared_ptr<const TweenSequence<T, Alloc>> chain = CallbacksOf(m_side[side]).endTween;
+				if (chain)
+				{
+					StartSequence(chain);
+				}
+				++side;
+			}
+
+			continue;
+		}
+
+		const float step = m_invDuration[i] * scale + 0.5f;
+		const unsigned int left = ProgressDone - progress;
+		const unsigned int next = step >= static_cast<float>(left) ? ProgressDone : progress + static_cast<unsigned int>(step);
+		m_state[i] = next << 8 | (state & 0xFF);
+
+		if (alive != i)
+		{
+			MoveTween(i, alive);
+		}
+		if (hasSide)
+		{
+			if (sideAlive != side)
+			{
+				m_side[sideAlive] = std::move(m_side[side]);
+			}
+			m_side[sideAlive].index = static_cast<unsigned int>(alive);
+			++sideAlive;
+			++side;
+		}
+		++alive;
+	}
+
+	// Tweens created by callbacks during the loop, their side entries follow the ones above
+	const size_t offset = count - alive;
+	for (size_t i = count; i < m_state.size(); ++i, ++alive)
+	{
+		MoveTween(i, alive);
+	}
+	for (size_t k = sideCount; k < m_side.size(); ++k, ++sideAlive)
+	{
+		m_side[sideAlive] = std::move(m_side[k]);
+		m_side[sideAlive].index -= static_cast<unsigned int>(offset);
 	}
+
+	TruncateTweens(alive);
+	m_side.erase(m_side.begin() + sideAlive, m_side.end());
 }
 
-template<class T>T STween<T>::Linear(float position, T start, T end)
+template<class T, class Alloc>size_t CompactTweenGroup<T, Alloc>::Size() const
 {
-	return static_cast<T>((end - start) * position + start);
+	return m_state.size();
 }
 
-template<class T>T STween<T>::QuadIn(float position, T start, T end)
+template<class T, class Alloc> void CompactTweenGroup<T, Alloc>::ReleaseTweens()
 {
-	return static_cast<T>((end - start) * position * position + start);
+	TruncateTweens(0);
+	m_side.clear();
+}
+
+template<class T, class Alloc> void CompactTweenGroup<T, Alloc>::AddBatch(TweenSpan<T* const> targets, TweenSpan<const T> finals, float duration, EasingFunction easing)
+{
+	const size_t count = std::min(targets.size(), finals.size());
+	const size_t needed = m_state.size() + count;
+	if (needed > m_state.capacity())
+	{
+		Reserve(std::max(needed, 2 * m_state.capacity()));
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (targets[i])
+			From(targets[i]);
+		else
+			From(finals[i]);
+		To(finals[i]).Time(duration).Easing(easing);
+	}
 }
 
-template<class T>T STween<T>::QuadOut(float position, T start, T end)
+template<class T, class Alloc> void CompactTweenGroup<T, Alloc>::Reserve(size_t count)
 {
-	return static_cast<T>(((end - start)* -1) * position * (position - 2) + start);
+	Detail::ColumnReserve reserve = { count };
+	ForEachColumn(reserve);
 }
 
-template<class T>T STween<T>::QuadInOut(float position, T start, T end)
+namespace Detail
+{
+// Unique address per type, identifies the pools of a TweenWorld without RTTI
+template<class Manager> struct TypeKey
 {
-	position *= 2;
-	if (position < 1)
-		return static_cast<T>(((end - start) / 2) * position * position + start);
+	static const char key;
+};
 
-	--position;
-	return static_cast<T>((((end - start) * 1) / 2)* (position * (position - 2) - 1) + start);
+template<class Manager> const char TypeKey<Manager>::key = 0;
 }
 
-template<class T>T STween<T>::CubicIn(float position, T start, T end)
+// Owns one manager per value type and updates all of them in a single call
+// TweenWorld<> world;
+// world.Tweens<float>().From(&alpha).To(1.0f).Time(0.3f);
+// world.Tweens<Vec2>().From(&position).To(Vec2(10, 0)).Time(1.0f);
+// world.Group<float, CubicOut>().From(&scale).To(2.0f).Time(0.5f);
+// world.Update(deltaTime);
+// Managers run on the clock of the world, Update() moves it once for all of them
+// and runs each step, scheduling, evaluation and finishing, over every manager before the next
+// Managers are allocated through 'Alloc', rebound to each of them, and use it for their storage
+// *Managers are created on first use and live as long as the world
+// *Update managers through the world, their own Update() and SetTickRate() move the shared clock
+template <class Alloc>
+class TweenWorld
+{
+public:
+	// Allocator of the managers of type T
+	template<class T> using AllocatorFor = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+
+	explicit TweenWorld(const Alloc& alloc = Alloc());
+	~TweenWorld();
+
+	// Manager for tweens of type T
+	template<class T> STween<T, AllocatorFor<T>>& Tweens();
+	// Group for tweens of type T eased with E
+	template<class T, EasingFunction E> StaticTweenGroup<T, E, AllocatorFor<T>>& Group();
+	// Processes every running tween of every manager
+	// With SetTickRate(), runs as many whole ticks as deltaTime adds up to
+	void Update(float deltaTime);
+	// Same as STween::SetTickRate(), for every manager
+	// *Groups made with Group() step by the time of the ticks
+	void SetTickRate(unsigned int ticksPerSecond);
+	// Same as STween::StepTicks(), for every manager
+	// *Does nothing unless SetTickRate() was called
+	void StepTicks(unsigned int ticks);
+	// Resets every manager
+	void ReleaseTweens();
+	// Same as STween::SetJobSystem(), for every current and future manager
+	// *Optional
+	void SetJobSystem(TweenJobSystem* jobSystem, size_t grain = 4096);
+
+private:
+	TweenWorld(const TweenWorld&);
+	TweenWorld& operator=(const TweenWorld&);
+
+	// Steps of Update() over one manager
+	struct Pool
+	{
+		virtual ~Pool() {}
+		// Takes submitted tweens and wakes delayed ones, before the clock moves
+		virtual void Schedule() = 0;
+		virtual void Evaluate(float deltaTime, unsigned int ticks) = 0;
+		// Drops finished tweens, once the clock has moved
+		virtual void Finish() = 0;
+		virtual void ReleaseTweens() = 0;
+		virtual void SetJobSystem(TweenJobSystem* jobSystem, size_t grain) = 0;
+		// Rounds running tweens to the ticks of the world clock, once its rate changed
+		virtual void AnchorTicks() = 0;
+		// Destroys the pool and gives its memory back through 'alloc'
+		virtual void Destroy(const Alloc& alloc) = 0;
+
+		const char* key;
+	};
+
+	template<class T> struct TweenPool : Pool
+	{
+		TweenPool(Detail::TweenClock& clock, const Alloc& alloc)
+			:manager(AllocatorFor<T>(alloc))
+		{
+			manager.m_sharedClock = &clock;
+		}
+
+		virtual void Schedule() { manager.ScheduleTweens(); }
+		virtual void Evaluate(float deltaTime, unsigned int ticks) { manager.EvaluateTweens(deltaTime, ticks); }
+		virtual void Finish() { manager.FinishTweens(); }
+		virtual void ReleaseTweens() { manager.ReleaseTweens(); }
+		virtual void SetJobSystem(TweenJobSystem* jobSystem, size_t grain) { manager.SetJobSystem(jobSystem, grain); }
+		virtual void AnchorTicks() { manager.AnchorAllTicks(); }
+		virtual void Destroy(const Alloc& alloc) { DestroyPool(this, alloc); }
+
+		STween<T, AllocatorFor<T>> manager;
+	};
+
+	// Groups have no delays nor ticks, their Update() is the whole evaluation
+	template<class T, EasingFunction E> struct GroupPool : Pool
+	{
+		GroupPool(Detail::TweenClock&, const Alloc& alloc)
+			:manager(AllocatorFor<T>(alloc))
+		{}
+
+		virtual void Schedule() {}
+		virtual void Evaluate(float deltaTime, unsigned int) { manager.Update(deltaTime); }
+		virtual void Finish() {}
+		virtual void ReleaseTweens() { manager.ReleaseTweens(); }
+		virtual void SetJobSystem(TweenJobSystem*, size_t) {}
+		virtual void AnchorTicks() {}
+		virtual void Destroy(const Alloc& alloc) { DestroyPool(this, alloc); }
+
+		StaticTweenGroup<T, E, AllocatorFor<T>> manager;
+	};
+
+	template<class P> P& PoolOf();
+	template<class P> static void DestroyPool(P* pool, const Alloc& alloc);
+	// Update() and StepTicks(), 'ticks' is only used in tick mode
+	void Advance(float deltaTime, unsigned int ticks);
+
+	Alloc m_allocator;
+	// One entry per value type, a dozen at most in practice so lookups are linear
+	TweenVector<Pool*, Alloc> m_pools;
+	// Shared by the managers of every pool
+	Detail::TweenClock m_clock;
+	TweenJobSystem* m_jobSystem;
+	size_t m_parallelGrain;
+};
+
+template<class Alloc>TweenWorld<Alloc>::TweenWorld(const Alloc& alloc)
+	:m_allocator(alloc),
+	m_pools(alloc),
+	m_clock(),
+	m_jobSystem(nullptr),
+	m_parallelGrain(4096)
+{}
+
+template<class Alloc>TweenWorld<Alloc>::~TweenWorld()
 {
-	return static_cast<T>((end - start) * position * position * position + start);
+	for (size_t i = 0; i < m_pools.size(); ++i)
+	{
+		m_pools[i]->Destroy(m_allocator);
+	}
 }
 
-template<class T>T STween<T>::CubicOut(float position, T start, T end)
+template<class Alloc> template<class P> P& TweenWorld<Alloc>::PoolOf()
 {
-	--position;
-	return static_cast<T>((end - start) * (position * position * position + 1) + start);
+	const char* key = &Detail::TypeKey<P>::key;
+	for (size_t i = 0; i < m_pools.size(); ++i)
+	{
+		if (m_pools[i]->key == key)
+		{
+			return *static_cast<P*>(m_pools[i]);
+		}
+	}
+
+	typedef AllocatorFor<P> PoolAllocator;
+	typedef std::allocator_traits<PoolAllocator> Traits;
+
+	// The entry is made first, nothing throws once the pool exists
+	m_pools.push_back(nullptr);
+	PoolAllocator allocator(m_allocator);
+	P* pool = Traits::allocate(allocator, 1);
+	try
+	{
+		Traits::construct(allocator, pool, m_clock, m_allocator);
+	}
+	catch (...)
+	{
+		Traits::deallocate(allocator, pool, 1);
+		m_pools.pop_back();
+		throw;
+	}
+
+	pool->key = key;
+	pool->SetJobSystem(m_jobSystem, m_parallelGrain);
+	m_pools.back() = pool;
+
+	return *pool;
 }
 
-template<class T>T STween<T>::CubicInOut(float position, T start, T end)
+template<class Alloc> template<class P> void TweenWorld<Alloc>::DestroyPool(P* pool, const Alloc& alloc)
 {
-	position *= 2;
-	if (position < 1)
-		return static_cast<T>(((end - start) / 2) * position * position * position + start);
+	typedef AllocatorFor<P> PoolAllocator;
+	typedef std::allocator_traits<PoolAllocator> Traits;
 
-	position -= 2;
-	return static_cast<T>(((end - start) / 2) * (position * position * position + 2) + start);
+	PoolAllocator allocator(alloc);
+	Traits::destroy(allocator, pool);
+	Traits::deallocate(allocator, pool, 1);
 }
 
-template<class T>T STween<T>::QuintIn(float position, T start, T end)
+template<class Alloc> template<class T> STween<T, typename TweenWorld<Alloc>::template AllocatorFor<T>>& TweenWorld<Alloc>::Tweens()
 {
-	return static_cast<T>((end - start) * position * position * position * position * position + start);
+	return PoolOf<TweenPool<T>>().manager;
 }
 
-template<class T>T STween<T>::QuintOut(float position, T start, T end)
+template<class Alloc> template<class T, EasingFunction E> StaticTweenGroup<T, E, typename TweenWorld<Alloc>::template AllocatorFor<T>>& TweenWorld<Alloc>::Group()
 {
-	--position;
-	return static_cast<T>((end - start) * (position * position * position * position * position + 1) + start);
+	return PoolOf<GroupPool<T, E>>().manager;
 }
 
-template<class T>T STween<T>::QuintInOut(float position, T start, T end)
+template<class Alloc> void TweenWorld<Alloc>::Update(float deltaTime)
 {
-	position *= 2;
-	if (position < 1)
-		return static_cast<T>(((end - start) / 2) * (position * position * position * position * position) + start);
+	if (!m_clock.tickRate)
+	{
+		Advance(deltaTime, 0);
+		return;
+	}
+
+	const unsigned int ticks = m_clock.AddTime(deltaTime);
+	if (ticks)
+	{
+		StepTicks(ticks);
+	}
+}
 
-	position -= 2;
-	return static_cast<T>(((end - start) / 2) * (position * position * position * position * position + 2) + start);
+template<class Alloc> void TweenWorld<Alloc>::SetTickRate(unsigned int ticksPerSecond)
+{
+	// Set once on the shared clock, the managers only round their tweens to it
+	m_clock.SetTickRate(ticksPerSecond);
+	for (size_t i = 0; i < m_pools.size(); ++i)
+	{
+		m_pools[i]->AnchorTicks();
+	}
 }
 
-template<class T>T STween<T>::BackIn(float position, T start, T end)
+template<class Alloc> void TweenWorld<Alloc>::StepTicks(unsigned int ticks)
 {
-	float s = 1.70158f;
-	float postFix = position;
-	return static_cast<T>((end - start) * postFix * position * ((s + 1) * position - s) + start);
+	if (m_clock.tickRate)
+	{
+		Advance(static_cast<float>(ticks * m_clock.tickSeconds), ticks);
+	}
 }
 
-template<class T>T STween<T>::BackOut(float position, T start, T end)
+template<class Alloc> void TweenWorld<Alloc>::Advance(float deltaTime, unsigned int ticks)
 {
-	float s = 1.70158f;
-	position--;
-	return static_cast<T>((end - start) * (position * position * ((s + 1) * position + s) + 1) + start);
+	STWEEN_ZONE("TweenWorld::Update");
+	// Managers created by callbacks start with the next Update()
+	const size_t count = m_pools.size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_pools[i]->Schedule();
+	}
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_pools[i]->Evaluate(deltaTime, ticks);
+	}
+	m_clock.Advance(deltaTime, ticks);
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_pools[i]->Finish();
+	}
 }
 
-template<class T>T STween<T>::BackInOut(float position, T start, T end)
+template<class Alloc> void TweenWorld<Alloc>::ReleaseTweens()
 {
-	float s = 1.70158f;
-	float t = position;
-	T b = start;
-	T c = end - start;
-	float d = 1;
-	s *= 1.525f;
-	if ((t /= d / 2) < 1)
-		return static_cast<T>(c / 2 * (t * t * ((s + 1) * t - s)) + b);
+	for (size_t i = 0; i < m_pools.size(); ++i)
+	{
+		m_pools[i]->ReleaseTweens();
+	}
+}
 
-	float postFix = t -= 2;
-	return static_cast<T>(c / 2 * (postFix * t * ((s + 1) * t + s) + 2) + b);
+template<class Alloc> void TweenWorld<Alloc>::SetJobSystem(TweenJobSystem* jobSystem, size_t grain)
+{
+	m_jobSystem = jobSystem;
+	m_parallelGrain = grain;
+	for (size_t i = 0; i < m_pools.size(); ++i)
+	{
+		m_pools[i]->SetJobSystem(jobSystem, grain);
+	}
 }
 }
 
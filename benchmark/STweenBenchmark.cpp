@@ -0,0 +1,681 @@
+// Simple Tween benchmarks
+// Measures the hot paths of STween so regressions show up between versions
+// Build from the repository root, e.g.:
+// g++ -std=c++14 -O2 -pthread -I. benchmark/STweenBenchmark.cpp -o STweenBenchmark
+// Built as C++20, coroutine resumption is measured as well
+// Usage: STweenBenchmark [filter] [--quick]
+// 'filter' only runs benchmarks whose name contains it, --quick stops at 100k tweens
+// Reports nanoseconds per tween and heap allocations per measured run,
+// a run being one frame for the Update benchmarks, then heap bytes per tween of each container
+
+#include "STween.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+// Every allocation made while a benchmark runs is counted
+// Each form of operator new is replaced along with its operator delete so the pairs stay matched,
+// the deletes are kept out of line so GCC does not see free() called on memory from operator new
+#if defined(_MSC_VER)
+#define BENCHMARK_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__)
+#define BENCHMARK_NOINLINE __attribute__((noinline))
+#else
+#define BENCHMARK_NOINLINE
+#endif
+
+static size_t g_allocations = 0;
+// Bytes requested so far, never decremented, see BenchmarkFootprint()
+static size_t g_allocatedBytes = 0;
+
+static void* CountedAllocate(size_t size) noexcept
+{
+	++g_allocations;
+	g_allocatedBytes += size;
+	return std::malloc(size ? size : 1);
+}
+
+void* operator new(size_t size)
+{
+	if (void* memory = CountedAllocate(size))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	if (void* memory = CountedAllocate(size))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return CountedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return CountedAllocate(size);
+}
+
+BENCHMARK_NOINLINE void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+BENCHMARK_NOINLINE void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+BENCHMARK_NOINLINE void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+BENCHMARK_NOINLINE void operator delete[](void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+BENCHMARK_NOINLINE void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+BENCHMARK_NOINLINE void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+const float FrameTime = 1.0f / 60.0f;
+// Long enough for a tween to outlive every measured frame
+const float LongDuration = 1.0e6f;
+// Minimum time measured per benchmark
+const double MinSeconds = 0.2;
+
+const char* EasingNames[] =
+{
+	"Linear", "QuadIn", "QuadOut", "QuadInOut", "CubicIn", "CubicOut", "CubicInOut",
+	"QuintIn", "QuintOut", "QuintInOut", "BackIn", "BackOut", "BackInOut"
+};
+
+struct Options
+{
+	std::string filter;
+	bool quick;
+};
+
+Options g_options;
+
+struct Result
+{
+	double nsPerItem;
+	double allocationsPerRun;
+};
+
+bool Selected(const std::string& name)
+{
+	return g_options.filter.empty() || name.find(g_options.filter) != std::string::npos;
+}
+
+void Report(const std::string& name, size_t items, const Result& result)
+{
+	std::printf("%-44s %9zu %12.2f %14.2f\n", name.c_str(), items, result.nsPerItem, result.allocationsPerRun);
+}
+
+double Seconds(Clock::time_point begin, Clock::time_point end)
+{
+	return std::chrono::duration<double>(end - begin).count();
+}
+
+// Calls setup() then run() until MinSeconds of run() went by
+// Only run() is timed and counted, 'items' items are processed per run
+template<class Setup, class Run>
+Result Measure(size_t items, Setup setup, Run run)
+{
+	size_t runs = 0;
+	size_t allocations = 0;
+	double seconds = 0;
+
+	while (seconds < MinSeconds || runs < 3)
+	{
+		setup();
+
+		const size_t allocationsBefore = g_allocations;
+		const Clock::time_point begin = Clock::now();
+		run();
+		const Clock::time_point end = Clock::now();
+		allocations += g_allocations - allocationsBefore;
+		seconds += Seconds(begin, end);
+		++runs;
+	}
+
+	Result result;
+	result.nsPerItem = seconds * 1.0e9 / (static_cast<double>(runs) * items);
+	result.allocationsPerRun = static_cast<double>(allocations) / runs;
+	return result;
+}
+
+template<class Run>
+Result Measure(size_t items, Run run)
+{
+	return Measure(items, [] {}, run);
+}
+
+std::vector<size_t> Sizes()
+{
+	std::vector<size_t> sizes;
+	sizes.push_back(1000);
+	sizes.push_back(10000);
+	sizes.push_back(100000);
+	if (!g_options.quick)
+		sizes.push_back(1000000);
+	return sizes;
+}
+
+// Update() throughput per easing function, pointer targets
+// 'sampled' evaluates through baked tables instead of the exact curves
+void BenchmarkUpdatePerEasing(bool batched, const STween::SampledEasing* sampled)
+{
+	const std::string prefix = std::string(batched ? "UpdateBatched" : "Update") + (sampled ? "Sampled/" : "/");
+
+	for (size_t size : Sizes())
+	{
+		for (int e = 0; e < STween::Detail::BuiltinEasingCount; ++e)
+		{
+			const std::string name = prefix + EasingNames[e];
+			if (!Selected(name))
+				continue;
+
+			std::vector<float> targets(size, 0.0f);
+			STween::STween<float> tweens;
+			tweens.SetBatchedEasing(batched);
+			tweens.SetSampledEasing(sampled);
+			for (size_t i = 0; i < size; ++i)
+			{
+				tweens.From(&targets[i]).To(1.0f).Time(LongDuration).Easing(static_cast<STween::EasingFunction>(e));
+			}
+			tweens.Update(FrameTime);
+
+			Report(name, size, Measure(size, [&] { tweens.Update(FrameTime); }));
+		}
+	}
+}
+
+// From(T*) writing through pointers versus From(T) with an OnStep() setter,
+// values read back in bulk with deferred callbacks, and pull mode where nothing is evaluated
+void BenchmarkPointerVersusCallback()
+{
+	for (size_t size : Sizes())
+	{
+		if (Selected("Update/Pointer"))
+		{
+			std::vector<float> targets(size, 0.0f);
+			STween::STween<float> tweens;
+			for (size_t i = 0; i < size; ++i)
+			{
+				tweens.From(&targets[i]).To(1.0f).Time(LongDuration).Easing(STween::CubicOut);
+			}
+
+			Report("Update/Pointer", size, Measure(size, [&] { tweens.Update(FrameTime); }));
+		}
+
+		if (Selected("Update/OnStep"))
+		{
+			std::vector<float> targets(size, 0.0f);
+			STween::STween<float> tweens;
+			for (size_t i = 0; i < size; ++i)
+			{
+				float* target = &targets[i];
+				tweens.From(0.0f).To(1.0f).Time(LongDuration).Easing(STween::CubicOut).OnStep([target](float& value) { *target = value; });
+			}
+
+			Report("Update/OnStep", size, Measure(size, [&] { tweens.Update(FrameTime); }));
+		}
+
+		if (Selected("Update/Deferred"))
+		{
+			std::vector<float> targets(size, 0.0f);
+			STween::STween<float> tweens;
+			tweens.SetDeferredCallbacks(true);
+			for (size_t i = 0; i < size; ++i)
+			{
+				tweens.From(0.0f).To(1.0f).Time(LongDuration).Easing(STween::CubicOut);
+			}
+			tweens.Update(FrameTime);
+
+			// Values are consumed in one copy, as for a GPU upload
+			Report("Update/Deferred", size, Measure(size, [&]
+			{
+				tweens.Update(FrameTime);
+				const STween::TweenSpan<const float> values = tweens.GetUpdatedValues();
+				std::copy(values.begin(), values.end(), targets.begin());
+			}));
+		}
+
+		if (Selected("Update/Pull"))
+		{
+			std::vector<float> targets(size, 0.0f);
+			STween::STween<float> tweens;
+			tweens.SetPullMode(true);
+			for (size_t i = 0; i < size; ++i)
+			{
+				tweens.From(&targets[i]).To(1.0f).Time(LongDuration).Easing(STween::CubicOut);
+			}
+
+			Report("Update/Pull", size, Measure(size, [&] { tweens.Update(FrameTime); }));
+		}
+	}
+}
+
+// Targets spread over components and tweened in random order, as written,
+// sorted by address with a separate write pass, and written to one output buffer
+void BenchmarkScatteredTargets()
+{
+	struct Component
+	{
+		float alpha;
+		char payload[60];
+	};
+
+	for (size_t size : Sizes())
+	{
+		std::vector<size_t> order(size);
+		for (size_t i = 0; i < size; ++i)
+		{
+			order[i] = i;
+		}
+		// Fixed seed so every run shuffles the same way
+		unsigned int seed = 12345;
+		for (size_t i = size; i-- > 1;)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			std::swap(order[i], order[seed % (i + 1)]);
+		}
+
+		for (int mode = 0; mode < 3; ++mode)
+		{
+			const char* names[] = { "Update/Scattered", "Update/ScatteredSorted", "Update/OutputBuffer" };
+			if (!Selected(names[mode]))
+				continue;
+
+			std::vector<Component> components(size);
+			std::vector<float> output(size, 0.0f);
+			STween::STween<float> tweens;
+			tweens.SetSortedTargets(mode != 0);
+			tweens.SetSeparateWrites(mode != 0);
+			if (mode == 2)
+				tweens.SetOutputBuffer(output);
+			for (size_t i = 0; i < size; ++i)
+			{
+				if (mode == 2)
+					tweens.From(0.0f).To(1.0f).Time(LongDuration).Easing(STween::CubicOut);
+				else
+					tweens.From(&components[order[i]].alpha).To(1.0f).Time(LongDuration).Easing(STween::CubicOut);
+			}
+			tweens.Update(FrameTime);
+
+			Report(names[mode], size, Measure(size, [&] { tweens.Update(FrameTime); }));
+		}
+	}
+}
+
+// Frame where every tween finishes at once and fires its finish callback
+void BenchmarkMassFinish()
+{
+	if (!Selected("MassFinish"))
+		return;
+
+	for (size_t size : Sizes())
+	{
+		std::vector<float> targets(size, 0.0f);
+		STween::STween<float> tweens;
+		size_t finished = 0;
+
+		Report("MassFinish", size, Measure(size, [&]
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				tweens.From(&targets[i]).To(1.0f).Time(0.0f).OnFinish([&finished] { ++finished; });
+			}
+		},
+		[&] { tweens.Update(FrameTime); }));
+	}
+}
+
+// Cost of walking a deep Chain() sequence, reported per chain link started
+void BenchmarkDeepChain()
+{
+	if (!Selected("Chain"))
+		return;
+
+	const size_t depth = 32;
+	const size_t widgets = 64;
+
+	float value = 0.0f;
+	std::vector<STween::STween<float>> links(depth);
+	for (size_t i = depth; i-- > 0;)
+	{
+		links[i].From(&value).To(static_cast<float>(i)).Time(0.0f);
+		if (i + 1 < depth)
+			links[i].Chain(&links[i + 1]);
+	}
+	std::shared_ptr<const STween::TweenSequence<float>> sequence = links[0].MakeSequence();
+
+	std::vector<float> targets(widgets, 0.0f);
+	STween::STween<float> tweens;
+
+	Report("Chain/Depth32", widgets * depth, Measure(widgets * depth, [&]
+	{
+		for (size_t i = 0; i < widgets; ++i)
+		{
+			tweens.From(&targets[i]).To(1.0f).Time(0.0f).Chain(sequence);
+		}
+
+		// Zero durations: one link starts per frame
+		for (size_t f = 0; f <= depth; ++f)
+		{
+			tweens.Update(FrameTime);
+		}
+	}));
+}
+
+// Builder cost of From().To().Time().Easing()
+void BenchmarkBuilder()
+{
+	if (!Selected("Builder"))
+		return;
+
+	for (size_t size : Sizes())
+	{
+		std::vector<float> targets(size, 0.0f);
+		STween::STween<float> tweens;
+
+		Report("Builder", size, Measure(size, [&] { tweens.ReleaseTweens(); }, [&]
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				tweens.From(&targets[i]).To(1.0f).Time(1.0f).Easing(STween::QuadranticOut);
+			}
+		}));
+	}
+}
+
+// Frames where nothing runs: empty managers, then managers whose tweens all wait for Delay()
+void BenchmarkIdle()
+{
+	for (size_t size : Sizes())
+	{
+		if (Selected("Idle/Empty"))
+		{
+			std::vector<STween::STween<float>> managers(size);
+
+			Report("Idle/Empty", size, Measure(size, [&]
+			{
+				for (size_t i = 0; i < size; ++i)
+				{
+					managers[i].Update(FrameTime);
+				}
+			}));
+		}
+
+		if (Selected("Idle/Delayed"))
+		{
+			std::vector<float> targets(size, 0.0f);
+			STween::STween<float> tweens;
+			for (size_t i = 0; i < size; ++i)
+			{
+				tweens.From(&targets[i]).To(1.0f).Time(1.0f).Delay(LongDuration);
+			}
+			tweens.Update(FrameTime);
+
+			Report("Idle/Delayed", size, Measure(size, [&] { tweens.Update(FrameTime); }));
+		}
+	}
+}
+
+// Catching up 100 ticks at once with StepTicks(), costs the same as a single tick
+void BenchmarkCatchUp()
+{
+	if (!Selected("StepTicks"))
+		return;
+
+	for (size_t size : Sizes())
+	{
+		std::vector<float> targets(size, 0.0f);
+		STween::STween<float> tweens;
+		tweens.SetTickRate(60);
+		for (size_t i = 0; i < size; ++i)
+		{
+			tweens.From(&targets[i]).To(1.0f).Time(LongDuration).Easing(STween::CubicOut);
+		}
+
+		Report("StepTicks/100", size, Measure(size, [&] { tweens.StepTicks(100); }));
+	}
+}
+
+// Ambient tweens going back and forth forever, wrapping in place instead of finishing
+void BenchmarkLoopForever()
+{
+	if (!Selected("Update/LoopForever"))
+		return;
+
+	for (size_t size : Sizes())
+	{
+		std::vector<float> targets(size, 0.0f);
+		STween::STween<float> tweens;
+		for (size_t i = 0; i < size; ++i)
+		{
+			// Spread so some tweens wrap every frame
+			tweens.From(&targets[i]).To(1.0f).Time(0.5f + static_cast<float>(i % 64) / 64.0f).Easing(STween::CubicOut).LoopForever(true);
+		}
+		tweens.Update(FrameTime);
+
+		Report("Update/LoopForever", size, Measure(size, [&] { tweens.Update(FrameTime); }));
+	}
+}
+
+// Update() throughput of CompactTweenGroup, same tweens as Update/QuadOut,
+// then with easing functions scattered across the tweens
+void BenchmarkUpdateCompact()
+{
+	for (size_t size : Sizes())
+	{
+		for (int mixed = 0; mixed < 2; ++mixed)
+		{
+			const char* name = mixed ? "Update/CompactMixed" : "Update/Compact";
+			if (!Selected(name))
+				continue;
+
+			std::vector<float> targets(size, 0.0f);
+			STween::CompactTweenGroup<float> tweens;
+			// Fixed seed so every run picks the same easing functions
+			unsigned int seed = 12345;
+			for (size_t i = 0; i < size; ++i)
+			{
+				seed = seed * 1664525u + 1013904223u;
+				const int easing = mixed ? static_cast<int>((seed >> 16) % STween::Detail::BuiltinEasingCount) : static_cast<int>(STween::QuadranticOut);
+				tweens.From(&targets[i]).To(1.0f).Time(LongDuration).Easing(static_cast<STween::EasingFunction>(easing));
+			}
+			tweens.Update(FrameTime);
+
+			Report(name, size, Measure(size, [&] { tweens.Update(FrameTime); }));
+		}
+	}
+}
+
+// Heap bytes held per running float tween: reserved, filled, then updated once so lazily grown buffers count too
+template<class Tweens>
+void ReportFootprint(const char* name, size_t size)
+{
+	if (!Selected(name))
+		return;
+
+	std::vector<float> targets(size, 0.0f);
+	const size_t bytesBefore = g_allocatedBytes;
+	{
+		Tweens tweens;
+		tweens.Reserve(size);
+		for (size_t i = 0; i < size; ++i)
+		{
+			tweens.From(&targets[i]).To(1.0f).Time(LongDuration);
+		}
+		tweens.Update(FrameTime);
+	}
+	std::printf("%-44s %9zu %12.2f\n", name, size, static_cast<double>(g_allocatedBytes - bytesBefore) / size);
+}
+
+void BenchmarkFootprint()
+{
+	if (!Selected("Footprint/STween") && !Selected("Footprint/StaticTweenGroup") && !Selected("Footprint/CompactTweenGroup"))
+		return;
+
+	const size_t size = 100000;
+	std::printf("\n%-44s %9s %12s\n", "Footprint", "Items", "bytes/item");
+	ReportFootprint<STween::STween<float>>("Footprint/STween", size);
+	ReportFootprint<STween::StaticTweenGroup<float, STween::Linear>>("Footprint/StaticTweenGroup", size);
+	ReportFootprint<STween::CompactTweenGroup<float>>("Footprint/CompactTweenGroup", size);
+}
+
+#ifdef STWEEN_COROUTINES
+// Coroutine started eagerly and never suspended at its end, frames free themselves
+struct Script
+{
+	struct promise_type
+	{
+		Script get_return_object() { return Script(); }
+		std::suspend_never initial_suspend() noexcept { return std::suspend_never(); }
+		std::suspend_never final_suspend() noexcept { return std::suspend_never(); }
+		void return_void() {}
+		void unhandled_exception() { std::abort(); }
+	};
+};
+
+Script WaitFor(STween::STween<float>& tweens, STween::TweenHandle handle, size_t& resumed)
+{
+	co_await tweens.Play(handle);
+	++resumed;
+}
+
+// Frame where every tween finishes and the coroutine awaiting each one resumes
+void BenchmarkCoroutineResume()
+{
+	if (!Selected("Coroutine/Resume"))
+		return;
+
+	for (size_t size : Sizes())
+	{
+		std::vector<float> targets(size, 0.0f);
+		STween::STween<float> tweens;
+		size_t resumed = 0;
+
+		Report("Coroutine/Resume", size, Measure(size, [&]
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				WaitFor(tweens, tweens.From(&targets[i]).To(1.0f).Time(0.0f).GetHandle(), resumed);
+			}
+		},
+		[&] { tweens.Update(FrameTime); }));
+	}
+}
+#endif
+
+// Same tweens as BenchmarkBuilder() submitted through a TweenSubmitQueue, then drained by one Update()
+// Submitted from this thread so queue overhead is measured without contention
+void BenchmarkSubmit()
+{
+	if (!Selected("Submit"))
+		return;
+
+	for (size_t size : Sizes())
+	{
+		std::vector<float> targets(size, 0.0f);
+		STween::TweenSubmitQueue<float> queue(size);
+		STween::STween<float> tweens;
+		tweens.SetSubmitQueue(&queue);
+
+		Report("Submit", size, Measure(size, [&] { tweens.ReleaseTweens(); }, [&]
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				queue.Submit(&targets[i], 0.0f, 1.0f, 1.0f, STween::QuadranticOut);
+			}
+			tweens.Update(FrameTime);
+		}));
+	}
+}
+
+// Same tweens as BenchmarkBuilder() created through AddBatch()
+void BenchmarkAddBatch()
+{
+	if (!Selected("AddBatch"))
+		return;
+
+	for (size_t size : Sizes())
+	{
+		std::vector<float> targets(size, 0.0f);
+		std::vector<float*> pointers(size);
+		for (size_t i = 0; i < size; ++i)
+		{
+			pointers[i] = &targets[i];
+		}
+		const std::vector<float> finals(size, 1.0f);
+		STween::STween<float> tweens;
+
+		Report("AddBatch", size, Measure(size, [&] { tweens.ReleaseTweens(); }, [&]
+		{
+			tweens.AddBatch(pointers, finals, 1.0f, STween::QuadranticOut);
+		}));
+	}
+}
+}
+
+int main(int argc, char** argv)
+{
+	g_options.quick = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--quick") == 0)
+			g_options.quick = true;
+		else
+			g_options.filter = argv[i];
+	}
+
+	std::printf("%-44s %9s %12s %14s\n", "Benchmark", "Items", "ns/item", "allocs/run");
+
+	const STween::SampledEasing sampled;
+	BenchmarkUpdatePerEasing(false, nullptr);
+	BenchmarkUpdatePerEasing(true, nullptr);
+	BenchmarkUpdatePerEasing(false, &sampled);
+	BenchmarkUpdatePerEasing(true, &sampled);
+	BenchmarkPointerVersusCallback();
+	BenchmarkScatteredTargets();
+	BenchmarkMassFinish();
+	BenchmarkDeepChain();
+	BenchmarkBuilder();
+	BenchmarkAddBatch();
+	BenchmarkSubmit();
+	BenchmarkIdle();
+	BenchmarkCatchUp();
+	BenchmarkLoopForever();
+	BenchmarkUpdateCompact();
+#ifdef STWEEN_COROUTINES
+	BenchmarkCoroutineResume();
+#endif
+	BenchmarkFootprint();
+
+	return 0;
+}
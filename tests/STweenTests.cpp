@@ -0,0 +1,1975 @@
+// Simple Tween tests
+// Smoke tests for behaviour the benchmark can't catch
+// Build from the repository root, e.g.:
+// g++ -std=c++14 -O2 -pthread -I. tests/STweenTests.cpp -o STweenTests
+// Usage: STweenTests [filter]
+// 'filter' only runs tests whose name contains it
+// Prints each failed check and returns the number of failures
+
+#include "STween.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+const float FrameTime = 1.0f / 60.0f;
+
+std::string g_filter;
+int g_failures = 0;
+
+void Check(bool condition, const char* expression, const char* test, int line)
+{
+	if (!condition)
+	{
+		std::printf("FAILED %s:%d: %s\n", test, line, expression);
+		++g_failures;
+	}
+}
+
+#define CHECK(condition) Check((condition), #condition, __FUNCTION__, __LINE__)
+
+// Calls test() if its name contains the filter
+void Run(const char* name, void (*test)())
+{
+	if (g_filter.empty() || std::string(name).find(g_filter) != std::string::npos)
+	{
+		const int failuresBefore = g_failures;
+		test();
+		std::printf("%-44s %s\n", name, g_failures == failuresBefore ? "ok" : "FAILED");
+	}
+}
+
+// Enough tweens created from inside callbacks to make every per-tween array grow
+const size_t SpawnCount = 1000;
+
+// Finish and step callbacks adding many tweens, with captures checked after the arrays grew
+// The captured string is too big for the inline buffer of TweenFunction, so it is allocated
+template<class Tweens>
+void SpawnFromCallbacks(Tweens& tweens)
+{
+	std::vector<float> spawned(2 * SpawnCount, 0.0f);
+	const std::string name(64, 'x');
+	float first = 0.0f;
+	float second = 0.0f;
+	size_t finishes = 0;
+	size_t steps = 0;
+	bool capturesIntact = true;
+
+	tweens.From(&first).To(1.0f).Time(0.1f).OnFinish([&, name]
+	{
+		for (size_t i = 0; i < SpawnCount; ++i)
+		{
+			tweens.From(&spawned[i]).To(1.0f).Time(0.05f).OnFinish([&finishes] { ++finishes; });
+		}
+		capturesIntact = capturesIntact && name.size() == 64;
+	});
+	tweens.From(&second).To(1.0f).Time(0.05f).OnStep([&, name](float&)
+	{
+		if (steps++ == 0)
+		{
+			for (size_t i = SpawnCount; i < 2 * SpawnCount; ++i)
+			{
+				tweens.From(&spawned[i]).To(2.0f).Time(0.05f);
+			}
+		}
+		capturesIntact = capturesIntact && name.size() == 64;
+	});
+
+	for (int frame = 0; frame < 30; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+
+	CHECK(capturesIntact);
+	CHECK(first == 1.0f && second == 1.0f);
+	CHECK(finishes == SpawnCount);
+	CHECK(spawned[0] == 1.0f && spawned[SpawnCount - 1] == 1.0f);
+	CHECK(spawned[SpawnCount] == 2.0f && spawned[2 * SpawnCount - 1] == 2.0f);
+	CHECK(tweens.Size() == 0);
+}
+
+void TestSpawnFromCallbacks()
+{
+	STween::STween<float> tweens;
+	SpawnFromCallbacks(tweens);
+
+	STween::StaticTweenGroup<float, STween::Linear> group;
+	SpawnFromCallbacks(group);
+
+	STween::CompactTweenGroup<float> compact;
+	SpawnFromCallbacks(compact);
+}
+
+// Same with deferred callbacks, which run after the values of every tween were written
+void TestSpawnFromDeferredCallbacks()
+{
+	STween::STween<float> tweens;
+	tweens.SetDeferredCallbacks(true);
+	SpawnFromCallbacks(tweens);
+}
+
+// Callbacks borrowed from a chained sequence spawning tweens
+void TestSpawnFromChainedCallbacks()
+{
+	STween::STween<float> tweens;
+	std::vector<float> spawned(SpawnCount, 0.0f);
+	float chained = 0.0f;
+	float first = 0.0f;
+
+	STween::STween<float> builder;
+	builder.From(&chained).To(1.0f).Time(0.05f).OnFinish([&]
+	{
+		for (size_t i = 0; i < SpawnCount; ++i)
+		{
+			tweens.From(&spawned[i]).To(1.0f).Time(0.05f);
+		}
+	});
+	tweens.From(&first).To(1.0f).Time(0.05f).Chain(builder.MakeSequence());
+
+	for (int frame = 0; frame < 30; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+
+	CHECK(first == 1.0f && chained == 1.0f);
+	CHECK(spawned[0] == 1.0f && spawned[SpawnCount - 1] == 1.0f);
+	CHECK(tweens.Size() == 0);
+}
+
+// Tweens of every kind in one manager, the same calls give the same tweens in another one
+const size_t MixCount = 96;
+
+struct Mix
+{
+	std::vector<float> targets;
+	std::vector<STween::TweenHandle> handles;
+	size_t finishes;
+	size_t steps;
+};
+
+// Which features AddMix() uses, the modes tested don't combine with all of them
+struct MixOptions
+{
+	bool delays;
+	bool callbacks;
+	const STween::TweenGroup* group;
+};
+
+void AddMix(STween::STween<float>& tweens, Mix& mix, const MixOptions& options)
+{
+	static const STween::EasingFunction easings[] = { STween::Linear, STween::QuadranticOut, STween::CubicInOut, STween::BackIn, STween::QuintOut };
+	mix.targets.assign(MixCount, 0.0f);
+	mix.handles.clear();
+	mix.finishes = 0;
+	mix.steps = 0;
+	for (size_t i = 0; i < MixCount; ++i)
+	{
+		mix.targets[i] = static_cast<float>(i % 3);
+		tweens.From(&mix.targets[i]).To(static_cast<float>(i % 7) - 3.0f).Time(0.2f + 0.013f * i).Easing(easings[i % 5]);
+		if (i % 5 == 1)
+			tweens.Reversed(true);
+		if (i % 6 == 2)
+			tweens.Yoyo(3);
+		else if (i % 6 == 4)
+			tweens.Loop(2);
+		else if (i % 23 == 3)
+			tweens.LoopForever(true);
+		if (options.delays && i % 4 == 3)
+			tweens.Delay(0.05f + 0.01f * i);
+		if (options.group && i % 3 == 0)
+			tweens.Group(options.group);
+		if (i % 8 == 5)
+			tweens.Owner(static_cast<unsigned int>(i % 3));
+		if (options.callbacks && i % 2 == 0)
+			tweens.OnFinish([&mix] { ++mix.finishes; });
+		if (options.callbacks && i % 7 == 1)
+			tweens.OnStep([&mix](float&) { ++mix.steps; });
+		mix.handles.push_back(tweens.GetHandle());
+	}
+}
+
+// Updates both managers, pausing the group for a while and slowing it down afterwards,
+// and returns false on the first frame their targets differ by more than 'tolerance'
+bool RunTogether(STween::STween<float>& reference, Mix& referenceMix, STween::STween<float>& tested, Mix& testedMix, STween::TweenGroup* group, float tolerance)
+{
+	for (int frame = 0; frame < 120; ++frame)
+	{
+		if (group)
+		{
+			if (frame == 10)
+				group->Pause();
+			if (frame == 25)
+				group->Resume();
+			if (frame == 40)
+				group->SetTimeScale(0.5f);
+		}
+		reference.Update(FrameTime);
+		tested.Update(FrameTime);
+		for (size_t i = 0; i < MixCount; ++i)
+		{
+			if (std::fabs(referenceMix.targets[i] - testedMix.targets[i]) > tolerance)
+			{
+				std::printf("  frame %d, tween %zu: %f instead of %f\n", frame, i, testedMix.targets[i], referenceMix.targets[i]);
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// Sorted targets, separate writes and an output buffer write the same values as a plain manager
+void TestSortedSeparateWrites()
+{
+	STween::TweenGroup group;
+	MixOptions grouped = { true, true, &group };
+
+	STween::STween<float> reference;
+	Mix referenceMix;
+	AddMix(reference, referenceMix, grouped);
+
+	STween::TweenGroup testedGroup;
+	grouped.group = &testedGroup;
+	STween::STween<float> tested;
+	tested.SetSortedTargets(true);
+	tested.SetSeparateWrites(true);
+	Mix testedMix;
+	AddMix(tested, testedMix, grouped);
+
+	// Tweens without target writing to the output buffer, mixed in with the others
+	std::vector<float> buffer(2 * MixCount, 0.0f);
+	tested.SetOutputBuffer(STween::TweenSpan<float>(buffer.data(), buffer.size()));
+	const STween::TweenHandle buffered = tested.From(0.0f).To(4.0f).Time(0.5f).Yoyo(2).GetHandle();
+	CHECK(buffered.index < buffer.size());
+
+	float highest = 0.0f;
+	for (int frame = 0; frame < 120; ++frame)
+	{
+		if (frame == 10)
+		{
+			group.Pause();
+			testedGroup.Pause();
+		}
+		if (frame == 25)
+		{
+			group.Resume();
+			testedGroup.Resume();
+		}
+		reference.Update(FrameTime);
+		tested.Update(FrameTime);
+		highest = std::max(highest, buffer[buffered.index]);
+	}
+	// Went there and back
+	CHECK(highest > 3.9f && highest <= 4.0f);
+	CHECK(buffer[buffered.index] == 0.0f);
+	CHECK(referenceMix.targets == testedMix.targets);
+	CHECK(referenceMix.finishes == testedMix.finishes && referenceMix.finishes > 0);
+	CHECK(referenceMix.steps == testedMix.steps && referenceMix.steps > 0);
+	CHECK(reference.Size() == tested.Size());
+}
+
+// Runs the first half of the ranges on another thread
+class TwoThreadJobs : public STween::TweenJobSystem
+{
+public:
+	void ParallelFor(size_t count, size_t grain, void (*job)(void* context, size_t begin, size_t end), void* context) override
+	{
+		const size_t ranges = (count + grain - 1) / grain;
+		const size_t split = (ranges / 2) * grain;
+		std::thread other([=] { RunRanges(0, split, grain, job, context); });
+		RunRanges(split, count, grain, job, context);
+		other.join();
+	}
+
+private:
+	static void RunRanges(size_t begin, size_t end, size_t grain, void (*job)(void*, size_t, size_t), void* context)
+	{
+		for (size_t first = begin; first < end; first += grain)
+		{
+			job(context, first, first + grain < end ? first + grain : end);
+		}
+	}
+};
+
+// Deferred callbacks with parallel evaluation write the same values as the serial immediate update
+void TestDeferredParallel()
+{
+	STween::TweenGroup group;
+	const MixOptions options = { true, true, &group };
+
+	STween::STween<float> reference;
+	Mix referenceMix;
+	AddMix(reference, referenceMix, options);
+
+	TwoThreadJobs jobs;
+	STween::STween<float> tested;
+	tested.SetDeferredCallbacks(true);
+	tested.SetJobSystem(&jobs, 16);
+	Mix testedMix;
+	AddMix(tested, testedMix, options);
+
+	CHECK(RunTogether(reference, referenceMix, tested, testedMix, &group, 0.0f));
+	CHECK(referenceMix.finishes == testedMix.finishes && referenceMix.finishes > 0);
+	CHECK(reference.Size() == tested.Size());
+}
+
+// Pull mode samples the values a plain manager writes, loops and yoyos included
+void TestPullLoops()
+{
+	const MixOptions options = { false, true, nullptr };
+
+	STween::STween<float> reference;
+	Mix referenceMix;
+	AddMix(reference, referenceMix, options);
+
+	STween::STween<float> tested;
+	tested.SetPullMode(true);
+	Mix testedMix;
+	AddMix(tested, testedMix, options);
+
+	// Update() writes the value a tween has before moving it forward, so it is sampled first
+	std::vector<float> sampled(MixCount, 0.0f);
+	std::vector<bool> running(MixCount, false);
+	bool same = true;
+	for (int frame = 0; frame < 120 && same; ++frame)
+	{
+		for (size_t i = 0; i < MixCount; ++i)
+		{
+			running[i] = tested.Sample(testedMix.handles[i], sampled[i]);
+		}
+		reference.Update(FrameTime);
+		tested.Update(FrameTime);
+		// Push mode sums float steps while pull mode reads a double clock,
+		// so a tween may end a frame apart in the two, by rounding only
+		for (size_t i = 0; i < MixCount; ++i)
+		{
+			// Finished tweens write their final value in both modes
+			if (!tested.IsAlive(testedMix.handles[i]))
+				same = same && std::fabs(testedMix.targets[i] - referenceMix.targets[i]) < 1e-4f;
+			else if (running[i])
+				same = same && std::fabs(sampled[i] - referenceMix.targets[i]) < 1e-4f;
+		}
+	}
+	CHECK(same);
+	CHECK(testedMix.steps == 0);
+	CHECK(referenceMix.finishes == testedMix.finishes && referenceMix.finishes > 0);
+}
+
+// In tick mode, loops and yoyos wrapping during a catch-up reach the same progress as tick by tick
+void TestTicksLoops()
+{
+	STween::TweenGroup group;
+	STween::TweenGroup batchedGroup;
+	MixOptions options = { false, true, &group };
+
+	STween::STween<float> single;
+	single.SetTickRate(60);
+	Mix singleMix;
+	AddMix(single, singleMix, options);
+
+	options.group = &batchedGroup;
+	STween::STween<float> batched;
+	batched.SetTickRate(60);
+	Mix batchedMix;
+	AddMix(batched, batchedMix, options);
+
+	bool same = true;
+	for (int tick = 1; tick <= 240; ++tick)
+	{
+		if (tick == 31)
+		{
+			group.Pause();
+			batchedGroup.Pause();
+		}
+		if (tick == 61)
+		{
+			group.Resume();
+			batchedGroup.Resume();
+		}
+		single.StepTicks(1);
+		if (tick % 3 != 0)
+		{
+			continue;
+		}
+
+		// Targets hold the value from before the last step, so the value at the progress reached is compared,
+		// a tween reaching its end only finishes on the next call, then its target has that value
+		batched.StepTicks(3);
+		for (size_t i = 0; i < MixCount; ++i)
+		{
+			float singleValue = singleMix.targets[i];
+			float batchedValue = batchedMix.targets[i];
+			single.Sample(singleMix.handles[i], singleValue);
+			batched.Sample(batchedMix.handles[i], batchedValue);
+			same = same && singleValue == batchedValue;
+		}
+	}
+	// Finishes the tweens left at their end
+	single.StepTicks(0);
+	batched.StepTicks(0);
+	CHECK(same);
+	CHECK(singleMix.finishes == batchedMix.finishes && singleMix.finishes > 0);
+	CHECK(single.Size() == batched.Size());
+}
+
+// Delayed tweens wait and then run on the clock of their group, which may be paused
+void TestDelayGroups()
+{
+	STween::STween<float> tweens;
+	STween::TweenGroup group;
+	float delayed = 0.0f;
+	float plain = 0.0f;
+	size_t finishes = 0;
+
+	group.Pause();
+	const STween::TweenHandle handle = tweens.From(&delayed).To(1.0f).Time(0.1f).Delay(0.2f).Group(&group).Yoyo(2).OnFinish([&finishes] { ++finishes; }).GetHandle();
+	tweens.From(&plain).To(1.0f).Time(0.1f).Delay(0.1f);
+	for (int frame = 0; frame < 30; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+	CHECK(plain == 1.0f);
+	CHECK(delayed == 0.0f && tweens.IsAlive(handle) && finishes == 0);
+	CHECK(std::fabs(tweens.GetTweens()[0].delay - 0.2f) < 1e-5f);
+
+	// Still has its whole delay to wait
+	group.Resume();
+	for (int frame = 0; frame < 11; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+	CHECK(delayed == 0.0f && tweens.IsAlive(handle));
+	for (int frame = 0; frame < 30; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+	CHECK(delayed == 0.0f && finishes == 1);
+	CHECK(!tweens.IsAlive(handle) && tweens.Size() == 0);
+
+	// Slowed down and paused through a parent, also in tick mode
+	for (int tickMode = 0; tickMode < 2; ++tickMode)
+	{
+		STween::STween<float> scaled;
+		scaled.SetTickRate(tickMode ? 4 : 0);
+		STween::TweenGroup parent;
+		STween::TweenGroup child(&parent);
+		parent.SetTimeScale(0.5f);
+		float value = 0.0f;
+		const STween::TweenHandle waiting = scaled.From(&value).To(1.0f).Time(0.5f).Delay(1.0f).Group(&child).GetHandle();
+		// Scales are ignored in tick mode
+		const float step = tickMode ? 0.25f : 0.125f;
+		scaled.Update(0.25f);
+		scaled.Update(0.25f);
+		CHECK(std::fabs(scaled.GetTweens()[0].delay - (1.0f - 2.0f * step)) < 1e-5f);
+
+		parent.Pause();
+		for (int frame = 0; frame < 8; ++frame)
+		{
+			scaled.Update(0.25f);
+		}
+		CHECK(std::fabs(scaled.GetTweens()[0].delay - (1.0f - 2.0f * step)) < 1e-5f);
+		CHECK(value == 0.0f && scaled.IsAlive(waiting));
+
+		parent.Resume();
+		parent.SetTimeScale(1.0f);
+		for (int frame = 0; frame < 8 && value == 0.0f; ++frame)
+		{
+			scaled.Update(0.25f);
+		}
+		CHECK(value > 0.0f && value < 1.0f);
+	}
+}
+
+// Copies own their delayed tweens, killing or finishing them in one manager leaves the other alone
+void TestCopyDelayed()
+{
+	STween::STween<float> original;
+	float killed = 0.0f;
+	float kept = 0.0f;
+	size_t finishes = 0;
+	const STween::TweenHandle killedHandle = original.From(&killed).To(1.0f).Time(0.1f).Delay(0.2f).GetHandle();
+	const STween::TweenHandle keptHandle = original.From(&kept).To(1.0f).Time(0.1f).Delay(0.1f).OnFinish([&finishes] { ++finishes; }).GetHandle();
+	// Parks both
+	original.Update(FrameTime);
+
+	STween::STween<float> copy = original;
+	CHECK(copy.Kill(killedHandle));
+	CHECK(!copy.IsAlive(killedHandle) && original.IsAlive(killedHandle));
+	CHECK(copy.IsAlive(keptHandle));
+
+	for (int frame = 0; frame < 30; ++frame)
+	{
+		original.Update(FrameTime);
+	}
+	CHECK(killed == 1.0f && kept == 1.0f && finishes == 1);
+	CHECK(!original.IsAlive(keptHandle) && original.Size() == 0);
+
+	// Still waiting where the original was copied
+	CHECK(copy.IsAlive(keptHandle));
+	kept = 0.0f;
+	for (int frame = 0; frame < 30; ++frame)
+	{
+		copy.Update(FrameTime);
+	}
+	CHECK(kept == 1.0f && finishes == 2);
+	CHECK(!copy.IsAlive(keptHandle) && copy.Size() == 0);
+
+	// Assigned over live tweens, which expire first
+	float replaced = 0.0f;
+	const STween::TweenHandle replacedHandle = original.From(&replaced).To(1.0f).Time(0.1f).Delay(0.1f).GetHandle();
+	original.Update(FrameTime);
+	original = copy;
+	CHECK(!original.IsAlive(replacedHandle) && original.Size() == 0);
+}
+
+// Retargeting a yoyo on its way back keeps it going back, with the plays it has left
+void TestRetargetYoyo()
+{
+	for (int keepVelocity = 0; keepVelocity < 2; ++keepVelocity)
+	{
+		STween::STween<float> tweens;
+		float value = 0.0f;
+		size_t finishes = 0;
+		const STween::TweenHandle handle = tweens.From(&value).To(1.0f).Time(0.5f).Yoyo(4).OnFinish([&finishes] { ++finishes; }).GetHandle();
+
+		// Halfway through the second play
+		int frame = 0;
+		for (; frame < 45; ++frame)
+		{
+			tweens.Update(FrameTime);
+		}
+		float current = 0.0f;
+		CHECK(tweens.Sample(handle, current) && current > 0.0f && current < 1.0f);
+		const std::vector<STween::TweenData<float>> before = tweens.GetTweens();
+		CHECK(tweens.Retarget(handle, -1.0f, keepVelocity != 0));
+		const std::vector<STween::TweenData<float>> after = tweens.GetTweens();
+		CHECK(after.size() == 1 && after[0].reversed && after[0].yoyo);
+		CHECK(after[0].loops == before[0].loops);
+
+		// Heads down to -1 right away, comes back up once, then ends at -1
+		// Keeping the velocity moves the other end past the current value so the curve goes through it
+		float lowest = current;
+		float highest = -1.0f;
+		bool wentUp = false;
+		for (; frame < 300 && tweens.IsAlive(handle); ++frame)
+		{
+			const float previous = value;
+			tweens.Update(FrameTime);
+			wentUp = wentUp || value > previous;
+			CHECK(wentUp || value <= previous);
+			lowest = std::min(lowest, value);
+			highest = std::max(highest, value);
+		}
+		CHECK(value == -1.0f && lowest == -1.0f && finishes == 1);
+		CHECK(wentUp && (keepVelocity ? highest > current : highest <= current + 1e-5f));
+		// Going three times as far at the same speed makes each play three times longer,
+		// or the current play starts over
+		const int expectedFrames = keepVelocity ? 270 : 135;
+		CHECK(frame >= expectedFrames && frame <= expectedFrames + 2);
+	}
+}
+
+// A looping timeline writes the value of the new cycle on the frame it wraps, cycles don't drift
+void TestTimelineLoop()
+{
+	float first = 0.0f;
+	float second = 0.0f;
+	size_t finishes = 0;
+	STween::STween<float> chained;
+	chained.From(&second).To(1.0f).Time(0.07f).OnFinish([&finishes] { ++finishes; });
+	STween::STween<float> builder;
+	builder.From(&first).To(1.0f).Time(0.04f).Chain(chained.MakeSequence());
+
+	STween::TweenTimeline<float> timeline(builder.MakeSequence());
+	timeline.SetLooping(true);
+	CHECK(std::fabs(timeline.GetDuration() - 0.11) < 1e-6);
+
+	bool onTime = true;
+	double time = 0.0;
+	for (int frame = 0; frame < 600; ++frame)
+	{
+		timeline.Update(FrameTime);
+		time += FrameTime;
+		// The first track runs for the first 0.04 seconds of each cycle
+		const double cycle = std::fmod(time, timeline.GetDuration());
+		if (cycle > 1e-4 && cycle < 0.04 - 1e-4)
+		{
+			onTime = onTime && std::fabs(first - cycle / 0.04) < 1e-3;
+		}
+		onTime = onTime && std::fabs(timeline.GetTime() - cycle) < 1e-4;
+	}
+	CHECK(onTime);
+	// One finish per cycle ended
+	CHECK(finishes == static_cast<size_t>(time / timeline.GetDuration()));
+}
+
+float SmoothStep(float t)
+{
+	return t * t * (3.0f - 2.0f * t);
+}
+
+// CompactTweenGroup writes the same values as STween across chunks of tweens,
+// reversed ones and easing functions kept in its side table
+void TestCompactMatches()
+{
+	// Custom easings past the 31 a compact tween stores inline
+	STween::EasingFunction sideEasing = STween::RegisterEasing(&SmoothStep);
+	while (static_cast<unsigned int>(sideEasing) < 31)
+	{
+		sideEasing = STween::RegisterEasing(&SmoothStep);
+	}
+	const STween::EasingFunction easings[] = { STween::Linear, STween::QuadranticOut, STween::CubicInOut, STween::BackIn, STween::QuintOut, sideEasing };
+
+	const size_t count = 600;
+	std::vector<float> referenceTargets(count, 0.0f);
+	std::vector<float> compactTargets(count, 0.0f);
+	std::vector<float> finals(count, 0.0f);
+	STween::STween<float> reference;
+	STween::CompactTweenGroup<float> compact;
+	size_t referenceSteps = 0;
+	size_t compactSteps = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		referenceTargets[i] = compactTargets[i] = 0.1f * (i % 9);
+		finals[i] = 0.3f * (i % 11) - 1.0f;
+		const float duration = 0.1f + 0.007f * (i % 50);
+		reference.From(&referenceTargets[i]).To(finals[i]).Time(duration).Easing(easings[i % 6]).Reversed(i % 4 == 1);
+		compact.From(&compactTargets[i]).To(finals[i]).Time(duration).Easing(easings[i % 6]).Reversed(i % 4 == 1);
+		if (i % 10 == 3)
+		{
+			reference.OnStep([&referenceSteps](float&) { ++referenceSteps; });
+			compact.OnStep([&compactSteps](float&) { ++compactSteps; });
+		}
+	}
+
+	bool close = true;
+	for (int frame = 0; frame < 40; ++frame)
+	{
+		reference.Update(FrameTime);
+		compact.Update(FrameTime);
+		for (size_t i = 0; i < count; ++i)
+		{
+			close = close && std::fabs(referenceTargets[i] - compactTargets[i]) < 1e-4f;
+		}
+	}
+	CHECK(close);
+	CHECK(compact.Size() == 0 && referenceSteps == compactSteps);
+
+	// Finished tweens land exactly on their end, the start for reversed ones
+	bool exact = true;
+	for (size_t i = 0; i < count; ++i)
+	{
+		exact = exact && compactTargets[i] == (i % 4 == 1 ? 0.1f * (i % 9) : finals[i]);
+	}
+	CHECK(exact);
+}
+
+// A snapshot taken halfway restores loops, delays left, owners and pause state into another manager
+void TestSnapshotMix()
+{
+	const MixOptions options = { true, false, nullptr };
+
+	STween::STween<float> original;
+	original.SetSortedTargets(true);
+	Mix originalMix;
+	AddMix(original, originalMix, options);
+	original.Pause(originalMix.handles[7]);
+	for (int frame = 0; frame < 20; ++frame)
+	{
+		original.Update(FrameTime);
+	}
+
+	std::vector<unsigned char> snapshot;
+	original.SaveSnapshot(snapshot, [&](STween::TweenHandle, float* target) { return static_cast<unsigned int>(target - originalMix.targets.data()); });
+
+	// Restored into a warm manager, its own tweens are replaced
+	STween::STween<float> restored;
+	Mix restoredMix;
+	AddMix(restored, restoredMix, options);
+	restored.Update(FrameTime);
+	restoredMix.targets = originalMix.targets;
+	CHECK(restored.LoadSnapshot(snapshot.data(), snapshot.size(), [&](unsigned int id) { return &restoredMix.targets[id]; }));
+	CHECK(restored.Size() == original.Size());
+
+	bool close = true;
+	for (int frame = 0; frame < 100; ++frame)
+	{
+		original.Update(FrameTime);
+		restored.Update(FrameTime);
+		for (size_t i = 0; i < MixCount; ++i)
+		{
+			close = close && std::fabs(originalMix.targets[i] - restoredMix.targets[i]) < 1e-4f;
+		}
+	}
+	CHECK(close);
+	CHECK(originalMix.targets[7] == restoredMix.targets[7]);
+	CHECK(restored.Size() == original.Size());
+}
+
+// Managers of a world run on its clock, including those created late, and come from its allocator
+void TestWorldClock()
+{
+	static unsigned char buffer[1 << 16];
+	STween::TweenArena arena(buffer, sizeof(buffer));
+	STween::TweenWorld<STween::TweenArenaAllocator<char>> world(arena);
+	world.SetTickRate(60);
+
+	STween::STween<float> singleFloat;
+	STween::STween<double> singleDouble;
+	STween::StaticTweenGroup<float, STween::QuadranticOut> singleGroup;
+	singleFloat.SetTickRate(60);
+	singleDouble.SetTickRate(60);
+
+	float worldFloat = 0.0f;
+	float singleFloatValue = 0.0f;
+	world.Tweens<float>().From(&worldFloat).To(1.0f).Time(0.5f).Delay(0.25f).Yoyo(2);
+	singleFloat.From(&singleFloatValue).To(1.0f).Time(0.5f).Delay(0.25f).Yoyo(2);
+	const size_t used = arena.GetUsed();
+	CHECK(used > 0);
+
+	double worldDouble = 0.0;
+	double singleDoubleValue = 0.0;
+	float worldGroup = 0.0f;
+	float singleGroupValue = 0.0f;
+	bool same = true;
+	for (int frame = 0; frame < 150; ++frame)
+	{
+		// Created once the world clock has moved, delays still count from now
+		if (frame == 20)
+		{
+			world.Tweens<double>().From(&worldDouble).To(2.0).Time(0.4f).Delay(0.1f);
+			singleDouble.From(&singleDoubleValue).To(2.0).Time(0.4f).Delay(0.1f);
+			world.Group<float, STween::QuadranticOut>().From(&worldGroup).To(3.0f).Time(0.3f);
+			singleGroup.From(&singleGroupValue).To(3.0f).Time(0.3f);
+			CHECK(arena.GetUsed() > used);
+		}
+
+		world.Update(FrameTime);
+		singleFloat.Update(FrameTime);
+		singleDouble.Update(FrameTime);
+		singleGroup.Update(static_cast<float>(1.0 / 60));
+		same = same && worldFloat == singleFloatValue && worldDouble == singleDoubleValue && worldGroup == singleGroupValue;
+	}
+	CHECK(same);
+	CHECK(worldFloat == 0.0f && worldDouble == 2.0 && worldGroup == 3.0f);
+	CHECK(world.Tweens<float>().Size() == 0 && world.Tweens<double>().Size() == 0);
+
+	world.Tweens<float>().From(&worldFloat).To(1.0f).Time(1.0f);
+	world.StepTicks(30);
+	world.StepTicks(0);
+	CHECK(worldFloat == 0.5f);
+
+	// A new rate is set once on the shared clock, the tweens of every manager are rounded to it
+	world.Tweens<double>().From(&worldDouble).To(4.0).Time(1.0f);
+	world.Update(0.5f / 60);
+	world.SetTickRate(30);
+	world.StepTicks(6);
+	world.StepTicks(0);
+	CHECK(std::fabs(worldFloat - 0.7f) < 1e-6f && std::fabs(worldDouble - 2.4) < 1e-6);
+	world.ReleaseTweens();
+	CHECK(world.Tweens<float>().Size() == 0);
+}
+
+// Batched curves match the scalar ones and run from 0 to 1,
+// QuadranticInOut goes through 0.5 at its midpoint without a jump
+void TestEasingCurves()
+{
+	const size_t samples = 1001;
+	bool same = true;
+	bool ends = true;
+	for (int e = 0; e < STween::Detail::BuiltinEasingCount; ++e)
+	{
+		const STween::EasingFunction easing = static_cast<STween::EasingFunction>(e);
+		std::vector<float> batched(samples);
+		for (size_t i = 0; i < samples; ++i)
+		{
+			batched[i] = static_cast<float>(i) / (samples - 1);
+		}
+		STween::Detail::EaseBatch(easing, batched.data(), samples);
+		for (size_t i = 0; i < samples; ++i)
+		{
+			same = same && std::fabs(batched[i] - STween::Detail::Ease(easing, static_cast<float>(i) / (samples - 1))) < 1e-5f;
+		}
+		ends = ends && std::fabs(batched[0]) < 1e-6f && std::fabs(batched[samples - 1] - 1.0f) < 1e-6f;
+	}
+	CHECK(same);
+	CHECK(ends);
+
+	const float below = STween::Detail::Ease(STween::QuadranticInOut, 0.4999f);
+	const float above = STween::Detail::Ease(STween::QuadranticInOut, 0.5001f);
+	CHECK(STween::Detail::Ease(STween::QuadranticInOut, 0.5f) == 0.5f);
+	CHECK(below < 0.5f && above > 0.5f && above - below < 1e-3f);
+	CHECK(std::fabs(STween::Detail::Ease(STween::QuadranticInOut, 0.75f) - 0.875f) < 1e-6f);
+}
+
+// Handles expire with their tween and never reach the tween reusing its slot,
+// live handles follow their tween when others are compacted away
+void TestStaleHandles()
+{
+	STween::STween<float> tweens;
+	float first = 0.0f;
+	float second = 0.0f;
+	float third = 0.0f;
+	CHECK(!tweens.IsAlive(STween::TweenHandle()) && !STween::TweenHandle().IsValid());
+
+	const STween::TweenHandle finished = tweens.From(&first).To(1.0f).Time(0.05f).GetHandle();
+	for (int frame = 0; frame < 5; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+	CHECK(first == 1.0f && !tweens.IsAlive(finished));
+
+	// Takes the slot of the finished tween under a new generation
+	const STween::TweenHandle reused = tweens.From(&second).To(2.0f).Time(1.0f).GetHandle();
+	CHECK(reused.index == finished.index && reused != finished);
+	CHECK(!tweens.Kill(finished) && !tweens.Pause(finished) && !tweens.Resume(finished) && !tweens.Seek(finished, 0.5f));
+	float sampled = 0.0f;
+	CHECK(!tweens.Sample(finished, sampled) && !tweens.Retarget(finished, 5.0f));
+	CHECK(tweens.IsAlive(reused));
+	tweens.Update(FrameTime);
+	tweens.Update(FrameTime);
+	CHECK(second > 0.0f && second < 2.0f);
+
+	// Killed once, the second call and the tween reusing the slot are left alone
+	CHECK(tweens.Kill(reused) && !tweens.Kill(reused));
+	const STween::TweenHandle next = tweens.From(&third).To(3.0f).Time(1.0f).GetHandle();
+	CHECK(next.index == reused.index && !tweens.Pause(reused) && tweens.IsAlive(next));
+
+	// Compaction moves the tweens after a killed one, their handles still find them
+	std::vector<float> values(8, 0.0f);
+	std::vector<STween::TweenHandle> handles;
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		handles.push_back(tweens.From(&values[i]).To(static_cast<float>(i)).Time(1.0f).GetHandle());
+	}
+	CHECK(tweens.Kill(handles[0]) && tweens.Kill(handles[3]));
+	tweens.Update(FrameTime);
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		CHECK(tweens.IsAlive(handles[i]) == (i != 0 && i != 3));
+	}
+	CHECK(tweens.Seek(handles[5], 1.0f));
+	tweens.Update(0.0f);
+	CHECK(values[5] == 5.0f && values[4] < 4.0f);
+}
+
+// A sequence chained by many tweens is shared rather than copied,
+// each chain starts its own tweens and calls the callbacks the sequence holds
+void TestSharedSequences()
+{
+	const size_t count = 20;
+	size_t lastFinishes = 0;
+	float last = 0.0f;
+	STween::STween<float> lastBuilder;
+	lastBuilder.From(3.0f).To(4.0f).Time(0.05f).OnFinish([&lastFinishes] { ++lastFinishes; });
+
+	// Chained by the sequence shared below
+	STween::STween<float> middleBuilder;
+	middleBuilder.From(1.0f).To(2.0f).Time(0.05f).OnStep([&last](float& value) { last = value; }).Chain(lastBuilder.MakeSequence());
+	const std::shared_ptr<const STween::TweenSequence<float>> sequence = middleBuilder.MakeSequence();
+	CHECK(sequence.use_count() == 1);
+
+	STween::STween<float> tweens;
+	std::vector<float> firsts(count, 0.0f);
+	for (size_t i = 0; i < count; ++i)
+	{
+		tweens.From(&firsts[i]).To(1.0f).Time(0.05f + 0.01f * i).Chain(sequence);
+	}
+	CHECK(sequence.use_count() == static_cast<long>(count + 1));
+
+	// Changing the builder afterwards leaves the captured sequence alone
+	middleBuilder.ReleaseTweens();
+	for (int frame = 0; frame < 90; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+	CHECK(firsts[0] == 1.0f && firsts[count - 1] == 1.0f);
+	CHECK(last == 2.0f && lastFinishes == count);
+	CHECK(tweens.Size() == 0 && sequence->start.size() == 1 && sequence->start[0] == 1.0f);
+	CHECK(sequence.use_count() == 1);
+}
+
+// Callable bigger than the inline buffer of TweenFunction, counts its calls through 'token'
+struct BigCallback
+{
+	std::shared_ptr<int> token;
+	char padding[64];
+
+	void operator()() const { ++*token; }
+};
+
+// TweenArena hands out aligned blocks until it runs out, TweenFunction keeps small callables inline,
+// allocates big ones through the allocator given and leaves moved-from functions empty
+void TestArenaCallbacks()
+{
+	unsigned char buffer[512];
+	STween::TweenArena arena(buffer, sizeof(buffer));
+	void* first = arena.Allocate(3, 1);
+	void* aligned = arena.Allocate(8, 8);
+	CHECK(first == buffer && reinterpret_cast<size_t>(aligned) % 8 == 0 && arena.GetUsed() >= 11);
+	bool threw = false;
+	const size_t used = arena.GetUsed();
+	try
+	{
+		arena.Allocate(sizeof(buffer), 1);
+	}
+	catch (const std::bad_alloc&)
+	{
+		threw = true;
+	}
+	CHECK(threw && arena.GetUsed() == used);
+	arena.Reset();
+	CHECK(arena.GetUsed() == 0 && arena.GetCapacity() == sizeof(buffer));
+
+	const std::shared_ptr<int> calls = std::make_shared<int>(0);
+	STween::TweenArenaAllocator<char> allocator(arena);
+	{
+		// Inline, nothing taken from the arena
+		STween::TweenFunction<void()> small(std::allocator_arg, allocator, [calls] { ++*calls; });
+		CHECK(arena.GetUsed() == 0 && calls.use_count() == 2);
+
+		BigCallback callback = BigCallback();
+		callback.token = calls;
+		STween::TweenFunction<void()> big(std::allocator_arg, allocator, callback);
+		CHECK(arena.GetUsed() >= sizeof(BigCallback) && calls.use_count() == 4);
+		small();
+		big();
+		CHECK(*calls == 2);
+
+		// Copies of a boxed callable are boxed again, moves hand the box over
+		STween::TweenFunction<void()> copy(big);
+		CHECK(calls.use_count() == 5);
+		STween::TweenFunction<void()> movedBig(std::move(big));
+		STween::TweenFunction<void()> movedSmall(std::move(small));
+		CHECK(!big && !small && movedBig && movedSmall && calls.use_count() == 5);
+		copy();
+		movedBig();
+		movedSmall();
+		CHECK(*calls == 5);
+
+		movedSmall = std::move(copy);
+		CHECK(!copy && calls.use_count() == 4);
+	}
+	CHECK(calls.use_count() == 1);
+
+	// Null callables stay empty
+	void (*none)() = nullptr;
+	CHECK(!STween::TweenFunction<void()>(none) && !STween::TweenFunction<void()>(std::function<void()>()));
+}
+
+// Adds 1 to each item of a range, see TestThreadPool()
+void CountRange(void* context, size_t begin, size_t end)
+{
+	std::atomic<int>* counts = static_cast<std::atomic<int>*>(context);
+	for (size_t i = begin; i < end; ++i)
+	{
+		++counts[i];
+	}
+}
+
+// TweenThreadPool runs each item once whatever the grain, and a manager updated through it
+// writes the same values as a serial one while its callbacks stay on the calling thread
+void TestThreadPool()
+{
+	STween::TweenThreadPool pool(4);
+	const size_t count = 1000;
+	std::vector<std::atomic<int>> counts(count);
+	const size_t grains[] = { 1, 7, 64, count, 5000 };
+	for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); ++g)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			counts[i] = 0;
+		}
+		pool.ParallelFor(count - g, grains[g], &CountRange, counts.data());
+		bool once = true;
+		for (size_t i = 0; i < count; ++i)
+		{
+			once = once && counts[i] == (i < count - g ? 1 : 0);
+		}
+		CHECK(once);
+	}
+	pool.ParallelFor(0, 16, &CountRange, counts.data());
+
+	const MixOptions options = { true, true, nullptr };
+	STween::STween<float> reference;
+	Mix referenceMix;
+	AddMix(reference, referenceMix, options);
+
+	STween::STween<float> tested;
+	tested.SetJobSystem(&pool, 8);
+	Mix testedMix;
+	AddMix(tested, testedMix, options);
+	const std::thread::id caller = std::this_thread::get_id();
+	bool onCaller = true;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		tested.From(0.0f).To(1.0f).Time(0.5f).OnStep([&onCaller, caller](float&) { onCaller = onCaller && std::this_thread::get_id() == caller; });
+		reference.From(0.0f).To(1.0f).Time(0.5f);
+	}
+
+	CHECK(RunTogether(reference, referenceMix, tested, testedMix, nullptr, 0.0f));
+	CHECK(referenceMix.finishes == testedMix.finishes && referenceMix.steps == testedMix.steps);
+	CHECK(onCaller);
+}
+
+// Runs a StaticTweenGroup next to STween with the same easing and returns false if their values part
+template<STween::EasingFunction E>
+bool StaticGroupMatches()
+{
+	const size_t count = 40;
+	std::vector<float> referenceTargets(count, 0.0f);
+	std::vector<float> groupTargets(count, 0.0f);
+	STween::STween<float> reference;
+	STween::StaticTweenGroup<float, E> group;
+	size_t referenceCalls = 0;
+	size_t groupCalls = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		referenceTargets[i] = groupTargets[i] = static_cast<float>(i % 4);
+		reference.From(&referenceTargets[i]).To(2.0f - i % 5).Time(0.1f + 0.01f * i).Easing(E).Reversed(i % 3 == 1);
+		group.From(&groupTargets[i]).To(2.0f - i % 5).Time(0.1f + 0.01f * i).Reversed(i % 3 == 1);
+		if (i % 4 == 0)
+		{
+			reference.OnFinish([&referenceCalls] { ++referenceCalls; }).OnStep([&referenceCalls](float&) { ++referenceCalls; });
+			group.OnFinish([&groupCalls] { ++groupCalls; }).OnStep([&groupCalls](float&) { ++groupCalls; });
+		}
+	}
+
+	bool close = true;
+	for (int frame = 0; frame < 40; ++frame)
+	{
+		reference.Update(FrameTime);
+		group.Update(FrameTime);
+		for (size_t i = 0; i < count; ++i)
+		{
+			close = close && std::fabs(referenceTargets[i] - groupTargets[i]) < 1e-5f;
+		}
+	}
+	return close && referenceTargets == groupTargets && referenceCalls == groupCalls && group.Size() == 0;
+}
+
+// StaticTweenGroup writes the values and calls the callbacks STween does, reversed tweens included
+void TestStaticGroup()
+{
+	CHECK(StaticGroupMatches<STween::Linear>());
+	CHECK(StaticGroupMatches<STween::QuadranticInOut>());
+	CHECK(StaticGroupMatches<STween::CubicOut>());
+	CHECK(StaticGroupMatches<STween::BackIn>());
+	CHECK(StaticGroupMatches<STween::QuintInOut>());
+}
+
+// Sampled curves stay within the documented 1e-4 of the exact ones at the default resolution,
+// the error measured while baking bounds them and shrinks with the square of the resolution
+void TestSampledEasing()
+{
+	const STween::SampledEasing sampled;
+	const STween::SampledEasing fine(512);
+	const size_t probes = 20001;
+	bool withinDoc = true;
+	bool withinMeasured = true;
+	bool quadratic = true;
+	bool rangeSame = true;
+	for (int e = 0; e < STween::Detail::BuiltinEasingCount; ++e)
+	{
+		const STween::EasingFunction easing = static_cast<STween::EasingFunction>(e);
+		std::vector<float> range(probes);
+		float maxError = 0.0f;
+		for (size_t i = 0; i < probes; ++i)
+		{
+			const float t = static_cast<float>(i) / (probes - 1);
+			range[i] = t;
+			maxError = std::max(maxError, std::fabs(sampled.Evaluate(easing, t) - STween::Detail::Ease(easing, t)));
+		}
+		sampled.EvaluateRange(easing, range.data(), probes);
+		for (size_t i = 0; i < probes; ++i)
+		{
+			rangeSame = rangeSame && std::fabs(range[i] - sampled.Evaluate(easing, static_cast<float>(i) / (probes - 1))) < 1e-6f;
+		}
+
+		withinDoc = withinDoc && maxError <= 1e-4f && sampled.MaxError(easing) <= 1e-4f;
+		withinMeasured = withinMeasured && maxError <= sampled.MaxError(easing) * 1.01f + 1e-7f;
+		quadratic = quadratic && fine.MaxError(easing) <= sampled.MaxError(easing) * 0.3f + 1e-7f;
+	}
+	CHECK(withinDoc && sampled.MaxError() <= 1e-4f);
+	CHECK(withinMeasured);
+	CHECK(quadratic);
+	CHECK(rangeSame);
+	CHECK(sampled.GetResolution() == 256 && STween::SampledEasing(1).GetResolution() == 2);
+
+	// Clamped outside [0, 1]
+	CHECK(sampled.Evaluate(STween::BackIn, -0.5f) == sampled.Evaluate(STween::BackIn, 0.0f));
+	CHECK(sampled.Evaluate(STween::BackOut, 1.5f) == sampled.Evaluate(STween::BackOut, 1.0f));
+
+	// A manager on the tables stays as close to an exact one
+	std::vector<float> exactTargets(STween::Detail::BuiltinEasingCount, 0.0f);
+	std::vector<float> sampledTargets(STween::Detail::BuiltinEasingCount, 0.0f);
+	STween::STween<float> exact;
+	STween::STween<float> tables;
+	tables.SetSampledEasing(&sampled);
+	for (int e = 0; e < STween::Detail::BuiltinEasingCount; ++e)
+	{
+		exact.From(&exactTargets[e]).To(1.0f).Time(0.5f).Easing(static_cast<STween::EasingFunction>(e));
+		tables.From(&sampledTargets[e]).To(1.0f).Time(0.5f).Easing(static_cast<STween::EasingFunction>(e));
+	}
+	bool close = true;
+	for (int frame = 0; frame < 40; ++frame)
+	{
+		exact.Update(FrameTime);
+		tables.Update(FrameTime);
+		for (int e = 0; e < STween::Detail::BuiltinEasingCount; ++e)
+		{
+			close = close && std::fabs(exactTargets[e] - sampledTargets[e]) <= 1e-4f;
+		}
+	}
+	CHECK(close && exactTargets == sampledTargets);
+}
+
+template<class V> struct SquareCurve
+{
+	static V Evaluate(V t) { return t * t; }
+};
+
+float HalfStep(float t)
+{
+	return t < 0.5f ? 0.0f : 1.0f;
+}
+
+// Registered curves get the next ids and are used by every easing path,
+// tables baked before the registration fall back to the exact curve, unknown ids ease linearly
+void TestCustomEasing()
+{
+	const STween::SampledEasing early;
+	const size_t before = STween::Detail::EasingCount();
+	const STween::EasingFunction step = STween::RegisterEasing(&HalfStep);
+	const STween::EasingFunction square = STween::RegisterEasing<SquareCurve>();
+	CHECK(static_cast<size_t>(step) == before && static_cast<size_t>(square) == before + 1);
+	CHECK(static_cast<int>(step) >= STween::Detail::BuiltinEasingCount && STween::Detail::EasingCount() == before + 2);
+	const STween::EasingFunction unknown = static_cast<STween::EasingFunction>(STween::Detail::EasingCount() + 5);
+
+	CHECK(STween::Detail::Ease(step, 0.4f) == 0.0f && STween::Detail::Ease(step, 0.6f) == 1.0f);
+	CHECK(STween::Detail::Ease(square, 0.5f) == 0.25f && STween::Detail::Ease(unknown, 0.3f) == 0.3f);
+	float squares[] = { 0.25f, 0.5f, 1.0f };
+	float steps[] = { 0.25f, 0.75f };
+	float unknowns[] = { 0.25f, 0.75f };
+	STween::Detail::EaseBatch(square, squares, 3);
+	STween::Detail::EaseBatch(step, steps, 2);
+	STween::Detail::EaseBatch(unknown, unknowns, 2);
+	CHECK(squares[0] == 0.0625f && squares[1] == 0.25f && squares[2] == 1.0f);
+	CHECK(steps[0] == 0.0f && steps[1] == 1.0f && unknowns[0] == 0.25f && unknowns[1] == 0.75f);
+	CHECK(early.Evaluate(square, 0.5f) == 0.25f);
+
+	// Exact, batched and sampled managers, tables baked after the registration
+	const STween::SampledEasing sampled;
+	CHECK(sampled.MaxError(square) < 1e-4f);
+	for (int mode = 0; mode < 3; ++mode)
+	{
+		STween::STween<float> tweens;
+		tweens.SetBatchedEasing(mode == 1);
+		tweens.SetSampledEasing(mode == 2 ? &sampled : nullptr);
+		float values[] = { 0.0f, 0.0f, 0.0f };
+		tweens.From(&values[0]).To(1.0f).Time(1.0f).Easing(step);
+		tweens.From(&values[1]).To(1.0f).Time(1.0f).Easing(square);
+		tweens.From(&values[2]).To(1.0f).Time(1.0f).Easing(unknown);
+		// 0.45 seconds in
+		for (int frame = 0; frame < 28; ++frame)
+		{
+			tweens.Update(FrameTime);
+		}
+		CHECK(values[0] == 0.0f && std::fabs(values[1] - 0.2025f) < 1e-4f && std::fabs(values[2] - 0.45f) < 1e-4f);
+		for (int frame = 0; frame < 40; ++frame)
+		{
+			tweens.Update(FrameTime);
+		}
+		CHECK(values[0] == 1.0f && values[1] == 1.0f && values[2] == 1.0f);
+	}
+}
+
+// Runs AddBatch() on any manager or group: every fourth target is nullptr and the finals span is longer
+// Returns false if the batch doesn't end where the builder would
+template<class Tweens>
+bool BatchLandsOnFinals(Tweens& tweens)
+{
+	const size_t count = 64;
+	std::vector<float> values(count, 0.0f);
+	std::vector<float*> targets(count);
+	std::vector<float> finals(count + 8);
+	for (size_t i = 0; i < finals.size(); ++i)
+	{
+		finals[i] = 0.5f * i;
+	}
+	for (size_t i = 0; i < count; ++i)
+	{
+		targets[i] = i % 4 == 2 ? nullptr : &values[i];
+	}
+
+	tweens.Reserve(count);
+	tweens.AddBatch(targets, finals, 0.25f);
+	if (tweens.Size() != count)
+	{
+		return false;
+	}
+	for (int frame = 0; frame < 20; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+
+	bool landed = tweens.Size() == 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		landed = landed && values[i] == (i % 4 == 2 ? 0.0f : finals[i]);
+	}
+	return landed;
+}
+
+// AddBatch() gives the tweens the builder would, nullptr targets included, and stays within Reserve()
+void TestAddBatch()
+{
+	STween::STween<float> tweens;
+	CHECK(BatchLandsOnFinals(tweens));
+	STween::StaticTweenGroup<float, STween::CubicOut> group;
+	CHECK(BatchLandsOnFinals(group));
+	STween::CompactTweenGroup<float> compact;
+	CHECK(BatchLandsOnFinals(compact));
+
+	// Same values as the builder, frame by frame
+	const size_t count = 100;
+	std::vector<float> built(count, 1.0f);
+	std::vector<float> batched(count, 1.0f);
+	std::vector<float*> targets(count);
+	std::vector<float> finals(count);
+	STween::STween<float> builder;
+	STween::STween<float> batch;
+	for (size_t i = 0; i < count; ++i)
+	{
+		targets[i] = &batched[i];
+		finals[i] = -static_cast<float>(i);
+		builder.From(&built[i]).To(finals[i]).Time(0.4f).Easing(STween::BackOut);
+	}
+	batch.Reserve(count);
+	batch.AddBatch(targets, finals, 0.4f, STween::BackOut);
+	CHECK(batch.IsAlive(batch.GetHandle()) && batch.Size() == count);
+
+	bool same = true;
+	for (int frame = 0; frame < 30; ++frame)
+	{
+		builder.Update(FrameTime);
+		batch.Update(FrameTime);
+		same = same && built == batched;
+#ifdef STWEEN_TRACK_ALLOCATIONS
+		CHECK(batch.GetUpdateAllocations() == 0);
+#endif
+	}
+	CHECK(same && batched[count - 1] == finals[count - 1]);
+
+	// Empty spans add nothing
+	batch.AddBatch(STween::TweenSpan<float* const>(), finals, 1.0f);
+	CHECK(batch.Size() == 0);
+}
+
+// Splice() moves every tween with its callbacks, delays and groups and expires the handles of the source,
+// View() exposes the running tweens in place, AddTweens() moves callbacks out of a temporary
+void TestSpliceView()
+{
+	STween::TweenGroup group;
+	std::vector<float> values(7, 0.0f);
+	const std::shared_ptr<int> finishes = std::make_shared<int>(0);
+	STween::STween<float> tweens;
+	STween::STween<float> other;
+	for (size_t i = 0; i < 3; ++i)
+	{
+		tweens.From(&values[i]).To(1.0f).Time(0.2f);
+	}
+	other.From(&values[3]).To(2.0f).Time(0.3f).Easing(STween::CubicIn).OnFinish([finishes] { ++*finishes; });
+	other.From(&values[4]).To(3.0f).Time(0.2f).Delay(0.1f);
+	other.From(&values[5]).To(4.0f).Time(0.2f).Group(&group);
+	const STween::TweenHandle last = other.From(&values[6]).To(5.0f).Time(0.4f).Reversed(true).GetHandle();
+	// Parks the delayed one
+	other.Update(FrameTime);
+
+	tweens.Splice(other);
+	CHECK(other.Size() == 0 && tweens.Size() == 7 && !other.IsAlive(last));
+	CHECK(tweens.IsAlive(tweens.GetHandle()) && finishes.use_count() == 2);
+	tweens.Splice(tweens);
+	CHECK(tweens.Size() == 7);
+
+	// The delayed tween waits aside, the others are viewed in storage order
+	tweens.Update(FrameTime);
+	const STween::TweenView<float> view = tweens.View();
+	CHECK(view.size == 6 && view.target.size() == 6 && view.progress.size() == 6);
+	bool spliced = false;
+	for (size_t i = 0; i < view.size; ++i)
+	{
+		CHECK(view.progress[i] > 0.0f && view.progress[i] < 1.0f);
+		if (view.target[i] == &values[3])
+		{
+			spliced = view.start[i] == 0.0f && view.end[i] == 2.0f && view.duration[i] == 0.3f && view.easing[i] == STween::CubicIn;
+		}
+	}
+	CHECK(spliced);
+
+	for (int frame = 0; frame < 40; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+	CHECK(values[3] == 2.0f && values[4] == 3.0f && values[5] == 4.0f && values[6] == 0.0f);
+	CHECK(*finishes == 1 && tweens.Size() == 0 && tweens.View().size == 0);
+
+	// Callbacks moved out of a temporary, copied from a kept container
+	other.From(&values[0]).To(1.0f).Time(0.1f).OnFinish([finishes] { ++*finishes; });
+	std::vector<STween::TweenData<float>> data = other.GetTweens();
+	CHECK(finishes.use_count() == 3);
+	tweens.AddTweens(STween::TweenSpan<const STween::TweenData<float>>(data));
+	CHECK(finishes.use_count() == 4);
+	tweens.AddTweens(std::move(data));
+	CHECK(finishes.use_count() == 4 && tweens.Size() == 2);
+}
+
+#ifdef STWEEN_STATS
+// Counters of the last Update() follow delays, step callbacks, finishes and chains, pull mode evaluates nothing
+void TestStats()
+{
+	STween::STween<float> builder;
+	builder.From(0.0f).To(1.0f).Time(0.1f);
+	builder.From(0.0f).To(1.0f).Time(0.1f);
+
+	STween::STween<float> tweens;
+	std::vector<float> values(10, 0.0f);
+	for (size_t i = 0; i < 5; ++i)
+	{
+		tweens.From(&values[i]).To(1.0f).Time(0.05f);
+	}
+	for (size_t i = 5; i < 8; ++i)
+	{
+		tweens.From(&values[i]).To(1.0f).Time(0.5f).OnStep([](float&) {});
+	}
+	tweens.From(&values[8]).To(1.0f).Time(0.5f).Delay(1.0f);
+	tweens.From(&values[9]).To(1.0f).Time(0.05f).Chain(builder.MakeSequence());
+
+	// The delayed tween is parked by the first Update()
+	tweens.Update(FrameTime);
+	const STween::TweenStats& stats = tweens.GetStats();
+	CHECK(stats.active == 10 && stats.parked == 1 && stats.evaluated == 9);
+	CHECK(stats.stepCallbacks == 3 && stats.finished == 0 && stats.chained == 0);
+	CHECK(stats.totalSeconds > 0.0 && stats.evaluateSeconds <= stats.totalSeconds);
+
+	// The short tweens and the chaining one finish on the fourth frame
+	tweens.Update(FrameTime);
+	tweens.Update(FrameTime);
+	tweens.Update(FrameTime);
+	CHECK(stats.active == 9 && stats.finished == 6 && stats.chained == 1);
+	CHECK(stats.callbackSeconds > 0.0 && stats.callbackSeconds <= stats.totalSeconds);
+
+	// Steps and the chained sequence are left
+	tweens.Update(FrameTime);
+	CHECK(stats.active == 5 && stats.evaluated == 5 && stats.finished == 0 && stats.parked == 1);
+
+	tweens.SetPullMode(true);
+	tweens.Update(FrameTime);
+	CHECK(stats.active == 5 && stats.evaluated == 0 && stats.stepCallbacks == 0);
+}
+#endif
+
+// Three floats without any operator, only tweenable as lanes, see TweenTraits below
+struct LaneVec3
+{
+	float x;
+	float y;
+	float z;
+};
+}
+
+namespace STween
+{
+template<> struct TweenTraits<LaneVec3>
+{
+	static const size_t Components = 3;
+};
+}
+
+namespace
+{
+// Sets QuadranticInOut on the last tween, static groups have it built in
+template<class Tweens> void EaseQuadInOut(Tweens& tweens)
+{
+	tweens.Easing(STween::QuadranticInOut);
+}
+
+template<class T, STween::EasingFunction E, class Alloc> void EaseQuadInOut(STween::StaticTweenGroup<T, E, Alloc>&)
+{
+}
+
+// Runs 'tweens' on vectors next to STween<float> on each of their components
+// Returns false if a component differs or a target doesn't end on its final value
+template<class Tweens>
+bool LanesMatchFloats(Tweens& tweens)
+{
+	const size_t count = 12;
+	std::vector<LaneVec3> vectors(count);
+	std::vector<float> floats(3 * count, 0.0f);
+	STween::STween<float> reference;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const LaneVec3 from = { 0.0f, 1.0f, -2.0f };
+		const LaneVec3 to = { 1.0f * i, -0.5f * i, 3.0f };
+		vectors[i] = from;
+		tweens.From(&vectors[i]).To(to).Time(0.1f + 0.02f * i).Reversed(i % 3 == 0);
+		EaseQuadInOut(tweens);
+		const float* begin = &from.x;
+		const float* end = &to.x;
+		for (size_t c = 0; c < 3; ++c)
+		{
+			floats[3 * i + c] = begin[c];
+			reference.From(&floats[3 * i + c]).To(end[c]).Time(0.1f + 0.02f * i).Easing(STween::QuadranticInOut).Reversed(i % 3 == 0);
+		}
+	}
+
+	bool same = true;
+	for (int frame = 0; frame < 30; ++frame)
+	{
+		tweens.Update(FrameTime);
+		reference.Update(FrameTime);
+		for (size_t i = 0; i < count; ++i)
+		{
+			same = same && std::fabs(vectors[i].x - floats[3 * i]) < 1e-5f && std::fabs(vectors[i].y - floats[3 * i + 1]) < 1e-5f
+				&& std::fabs(vectors[i].z - floats[3 * i + 2]) < 1e-5f;
+		}
+	}
+	for (size_t i = 0; i < count; ++i)
+	{
+		same = same && vectors[i].x == floats[3 * i] && vectors[i].y == floats[3 * i + 1] && vectors[i].z == floats[3 * i + 2];
+	}
+	return same && tweens.Size() == 0;
+}
+
+// Types declaring their float components through TweenTraits are tweened lane by lane without operators,
+// by STween and both groups
+void TestTraitsLanes()
+{
+	STween::STween<LaneVec3> tweens;
+	CHECK(LanesMatchFloats(tweens));
+	STween::STween<LaneVec3> batched;
+	batched.SetBatchedEasing(true);
+	CHECK(LanesMatchFloats(batched));
+	STween::StaticTweenGroup<LaneVec3, STween::QuadranticInOut> group;
+	CHECK(LanesMatchFloats(group));
+	STween::CompactTweenGroup<LaneVec3> compact;
+	CHECK(LanesMatchFloats(compact));
+}
+
+// With coalescing each target keeps its latest tween, found through FindTarget() and retargeted without a jump
+void TestCoalesceRetarget()
+{
+	const size_t count = 200;
+	std::vector<float> values(count, 0.0f);
+	size_t finishes = 0;
+	STween::STween<float> tweens;
+	CHECK(!tweens.FindTarget(&values[0]).IsValid());
+	tweens.SetCoalesceTargets(true);
+
+	std::vector<STween::TweenHandle> first(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		first[i] = tweens.From(&values[i]).To(1.0f).Time(0.5f).OnFinish([&finishes] { ++finishes; }).GetHandle();
+	}
+	bool found = true;
+	for (size_t i = 0; i < count; ++i)
+	{
+		found = found && tweens.FindTarget(&values[i]) == first[i];
+	}
+	CHECK(found && tweens.Size() == count);
+	tweens.Update(FrameTime);
+
+	// A second tween on half of the targets kills the first one, without its callback
+	std::vector<STween::TweenHandle> second(count);
+	for (size_t i = 0; i < count; i += 2)
+	{
+		second[i] = tweens.From(&values[i]).To(-1.0f).Time(0.5f).GetHandle();
+	}
+	bool replaced = true;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const bool even = i % 2 == 0;
+		replaced = replaced && tweens.IsAlive(first[i]) != even && tweens.FindTarget(&values[i]) == (even ? second[i] : first[i]);
+	}
+	CHECK(replaced);
+	// Killed tweens leave the arrays on the next Update()
+	tweens.Update(FrameTime);
+	CHECK(tweens.Size() == count);
+
+	// Retargeted halfway, keeping the velocity: no jump, and further away so it ends later
+	for (int frame = 0; frame < 15; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+	const float before = values[1];
+	CHECK(tweens.Retarget(tweens.FindTarget(&values[1]), 3.0f, true));
+	tweens.Update(FrameTime);
+	CHECK(values[1] > before && values[1] - before < 0.2f);
+	// Restarting from the current value instead
+	const float restarted = values[3];
+	CHECK(tweens.Retarget(tweens.FindTarget(&values[3]), 3.0f));
+	tweens.Update(FrameTime);
+	CHECK(values[3] >= restarted && values[3] - restarted < 0.1f);
+
+	for (int frame = 0; frame < 20; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+	CHECK(values[0] == -1.0f && values[1] < 3.0f && values[2] == -1.0f && values[3] < 3.0f && values[5] == 1.0f);
+	CHECK(tweens.FindTarget(&values[1]).IsValid() && tweens.FindTarget(&values[3]).IsValid());
+	CHECK(finishes == count / 2 - 2);
+
+	// A waiting tween only gets its final value replaced
+	float delayed = 0.0f;
+	const STween::TweenHandle waiting = tweens.From(&delayed).To(1.0f).Time(0.1f).Delay(0.2f).GetHandle();
+	tweens.Update(FrameTime);
+	CHECK(tweens.FindTarget(&delayed) == waiting && tweens.Retarget(waiting, 2.0f, true));
+	for (int frame = 0; frame < 30; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+	CHECK(delayed == 2.0f);
+
+	tweens.SetCoalesceTargets(false);
+	CHECK(!tweens.FindTarget(&values[3]).IsValid());
+}
+
+// A timeline writes each track at the exact time it reached and seeks both ways without calling back,
+// later tracks on the same target overriding earlier ones
+void TestTimelineSeek()
+{
+	float x = 0.0f;
+	float y = 0.0f;
+	size_t finishes = 0;
+	STween::STween<float> second;
+	second.From(&y).To(2.0f).Time(0.3f).OnFinish([&finishes] { ++finishes; });
+	second.From(&x).To(5.0f).Time(0.1f);
+	STween::STween<float> first;
+	first.From(&x).To(1.0f).Time(0.2f).Easing(STween::QuadranticOut).Chain(second.MakeSequence());
+
+	STween::TweenTimeline<float> timeline(first.MakeSequence());
+	CHECK(timeline.Size() == 3 && std::fabs(timeline.GetDuration() - 0.5) < 1e-6);
+
+	// x eases to 1 then starts over towards 5 at 0.2 seconds, when y starts
+	bool onCurve = true;
+	for (int frame = 0; frame < 40; ++frame)
+	{
+		timeline.Update(FrameTime);
+		const double time = timeline.GetTime();
+		const float expectedX = time < 0.2 ? STween::Detail::Ease(STween::QuadranticOut, static_cast<float>(time / 0.2))
+			: static_cast<float>(std::min(5.0 * (time - 0.2) / 0.1, 5.0));
+		const float expectedY = time < 0.2 ? 0.0f : static_cast<float>(std::min(2.0 * (time - 0.2) / 0.3, 2.0));
+		onCurve = onCurve && std::fabs(x - expectedX) < 1e-4f && std::fabs(y - expectedY) < 1e-4f;
+	}
+	CHECK(onCurve && timeline.IsFinished() && finishes == 1);
+	CHECK(x == 5.0f && y == 2.0f);
+
+	// Backwards into the first track, the others aren't written
+	timeline.Seek(0.1);
+	CHECK(std::fabs(x - STween::Detail::Ease(STween::QuadranticOut, 0.5f)) < 1e-6f && y == 2.0f);
+	CHECK(!timeline.IsFinished() && timeline.GetTime() == 0.1);
+	// Forwards past the start of the last track, which overrides the first one on x
+	timeline.Seek(0.25);
+	CHECK(std::fabs(x - 2.5f) < 1e-5f && std::fabs(y - 2.0f * 0.05f / 0.3f) < 1e-5f);
+	CHECK(finishes == 1);
+
+	// Playback goes on from there, calling back again
+	timeline.Seek(0.45);
+	timeline.Update(0.1f);
+	CHECK(timeline.IsFinished() && x == 5.0f && y == 2.0f && finishes == 2);
+}
+
+#ifdef STWEEN_COROUTINES
+// Coroutine started eagerly and never suspended at its end, frames free themselves
+struct Script
+{
+	struct promise_type
+	{
+		Script get_return_object() { return Script(); }
+		std::suspend_never initial_suspend() noexcept { return std::suspend_never(); }
+		std::suspend_never final_suspend() noexcept { return std::suspend_never(); }
+		void return_void() {}
+		void unhandled_exception() { std::abort(); }
+	};
+};
+
+// Awaits 'handle', then a tween it starts itself, counting each resume in 'stage'
+Script PlayTwice(STween::STween<float>& tweens, STween::TweenHandle handle, float& value, int& stage)
+{
+	co_await tweens.Play(handle);
+	stage = 1;
+	co_await tweens.Play(tweens.From(&value).To(2.0f).Time(0.1f).GetHandle());
+	stage = 2;
+}
+
+Script WaitBoth(STween::STween<float>& floats, STween::TweenHandle a, STween::STween<double>& doubles, STween::TweenHandle b, int& stage)
+{
+	co_await STween::AllOf(floats.Play(a), doubles.Play(b));
+	stage = 1;
+}
+
+// Coroutines resume at the end of the Update() their tweens finished or were killed in,
+// AllOf() waits for every manager and expired handles don't suspend
+void TestAwaiters()
+{
+	STween::STween<float> floats;
+	float value = 0.0f;
+	int stage = 0;
+	PlayTwice(floats, floats.From(&value).To(1.0f).Time(0.1f).GetHandle(), value, stage);
+	int frame = 0;
+	for (; stage == 0 && frame < 60; ++frame)
+	{
+		floats.Update(FrameTime);
+	}
+	CHECK(stage == 1 && value == 1.0f && frame >= 6 && frame <= 8);
+	for (; stage == 1 && frame < 60; ++frame)
+	{
+		floats.Update(FrameTime);
+	}
+	CHECK(stage == 2 && value == 2.0f && frame >= 12 && frame <= 16);
+
+	// Killed: resumed by the next Update() without the tween finishing
+	float killed = 0.0f;
+	int killedStage = 0;
+	const STween::TweenHandle handle = floats.From(&killed).To(1.0f).Time(10.0f).GetHandle();
+	PlayTwice(floats, handle, killed, killedStage);
+	floats.Update(FrameTime);
+	CHECK(killedStage == 0 && floats.Kill(handle));
+	floats.Update(FrameTime);
+	CHECK(killedStage == 1);
+
+	// Waits for the slower of two managers
+	STween::STween<double> doubles;
+	double slow = 0.0;
+	int bothStage = 0;
+	WaitBoth(floats, floats.From(0.0f).To(1.0f).Time(0.05f).GetHandle(), doubles, doubles.From(&slow).To(1.0).Time(0.2f).GetHandle(), bothStage);
+	for (frame = 0; frame < 10; ++frame)
+	{
+		floats.Update(FrameTime);
+		doubles.Update(FrameTime);
+	}
+	CHECK(bothStage == 0 && floats.Size() == 0 && slow < 1.0);
+	for (frame = 0; frame < 10; ++frame)
+	{
+		floats.Update(FrameTime);
+		doubles.Update(FrameTime);
+	}
+	CHECK(bothStage == 1 && slow == 1.0);
+
+	// Expired already, runs on without suspending
+	int expiredStage = 0;
+	WaitBoth(floats, handle, doubles, STween::TweenHandle(), expiredStage);
+	CHECK(expiredStage == 1);
+}
+#endif
+
+// Submits 'count' tweens whose final value encodes the producer and their order, retrying while the queue is full
+void Produce(STween::TweenSubmitQueue<float>* queue, int producer, int count)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		while (!queue->Submit(nullptr, 0.0f, static_cast<float>(producer * 100000 + i), 1.0f))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+// The ring refuses tweens while full and keeps their order across many wraparounds,
+// concurrent producers each get every tween through once and in order
+void TestSubmitQueue()
+{
+	STween::TweenSubmitQueue<float> queue(5);
+	CHECK(queue.Capacity() == 8 && queue.Empty());
+
+	size_t finishes = 0;
+	STween::TweenData<float> data(0);
+	data.fromReady = true;
+	data.byPointer = false;
+	data.initialCpy = 0.0f;
+	data.finalValue = 1.0f;
+	data.duration = 0.1f;
+	data.timeCounter = 0.0f;
+	data.finishCallback = [&finishes] { ++finishes; };
+	for (size_t i = 0; i < queue.Capacity(); ++i)
+	{
+		CHECK(queue.Submit(nullptr, 0.0f, static_cast<float>(i), 1.0f));
+	}
+	CHECK(!queue.Submit(std::move(data)) && data.finishCallback && !queue.Empty());
+
+	// Drained oldest first, then wrapped around many times
+	std::vector<float> drained;
+	queue.Drain([&drained](STween::TweenData<float>&& tween) { drained.push_back(tween.finalValue); });
+	bool ordered = drained.size() == queue.Capacity();
+	for (int round = 0; round < 100; ++round)
+	{
+		for (int i = 0; i < 5; ++i)
+		{
+			ordered = ordered && queue.Submit(nullptr, 0.0f, static_cast<float>(round * 5 + i), 1.0f);
+		}
+		drained.clear();
+		queue.Drain([&drained](STween::TweenData<float>&& tween) { drained.push_back(tween.finalValue); });
+		for (int i = 0; i < 5; ++i)
+		{
+			ordered = ordered && drained.size() == 5 && drained[i] == static_cast<float>(round * 5 + i);
+		}
+	}
+	CHECK(ordered && queue.Empty());
+
+	// Taken by Update() with their callbacks
+	STween::STween<float> tweens;
+	tweens.SetSubmitQueue(&queue);
+	CHECK(queue.Submit(std::move(data)));
+	tweens.Update(FrameTime);
+	CHECK(tweens.Size() == 1);
+	for (int frame = 0; frame < 10; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+	CHECK(finishes == 1 && tweens.Size() == 0);
+	tweens.SetSubmitQueue(nullptr);
+
+	// Four producers on a small ring, drained while they run
+	const int producers = 4;
+	const int perProducer = 5000;
+	STween::TweenSubmitQueue<float> shared(64);
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; ++p)
+	{
+		threads.push_back(std::thread(&Produce, &shared, p, perProducer));
+	}
+	std::vector<int> next(producers, 0);
+	bool inOrder = true;
+	int received = 0;
+	while (received < producers * perProducer)
+	{
+		shared.Drain([&](STween::TweenData<float>&& tween)
+		{
+			const int value = static_cast<int>(tween.finalValue);
+			const int producer = value / 100000;
+			inOrder = inOrder && producer < producers && value % 100000 == next[producer];
+			++next[producer];
+			++received;
+		});
+	}
+	for (size_t t = 0; t < threads.size(); ++t)
+	{
+		threads[t].join();
+	}
+	CHECK(inOrder && received == producers * perProducer && shared.Empty());
+}
+
+// A paused tween waiting for its Delay() keeps the wait it had left, wherever it goes meanwhile
+void TestPauseDelayed()
+{
+	STween::STween<float> tweens;
+	float value = 0.0f;
+	const STween::TweenHandle handle = tweens.From(&value).To(1.0f).Time(1.0f).Delay(1.0f).GetHandle();
+	// Parks it with 0.5 s left
+	tweens.Update(0.5f);
+	CHECK(tweens.Pause(handle));
+	for (int frame = 0; frame < 4; ++frame)
+	{
+		tweens.Update(0.5f);
+	}
+	CHECK(tweens.Resume(handle));
+	CHECK(std::fabs(tweens.GetTweens()[0].delay - 0.5f) < 1e-5f);
+	tweens.Update(0.25f);
+	tweens.Update(0.25f);
+	CHECK(value == 0.0f && tweens.IsAlive(handle));
+	// Wakes, then moves
+	tweens.Update(0.25f);
+	tweens.Update(0.25f);
+	CHECK(value > 0.0f && value < 1.0f);
+
+	// Paused before being parked, then paused and resumed many times on one frame, it wakes once
+	size_t finishes = 0;
+	float other = 0.0f;
+	const STween::TweenHandle twice = tweens.From(&other).To(1.0f).Time(0.1f).Delay(0.5f).OnFinish([&finishes] { ++finishes; }).GetHandle();
+	CHECK(tweens.Pause(twice));
+	tweens.Update(1.0f);
+	CHECK(tweens.Resume(twice) && tweens.Pause(twice) && tweens.Resume(twice) && tweens.Pause(twice) && tweens.Resume(twice));
+	for (int frame = 0; frame < 40; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+	CHECK(other == 1.0f && finishes == 1 && !tweens.IsAlive(twice));
+
+	// Splice takes it paused with the same wait left
+	STween::STween<float> source;
+	float moved = 0.0f;
+	const STween::TweenHandle spliced = source.From(&moved).To(1.0f).Time(0.1f).Delay(0.5f).GetHandle();
+	source.Update(0.25f);
+	CHECK(source.Pause(spliced));
+	source.Update(1.0f);
+	tweens.Splice(source);
+	const STween::TweenHandle received = tweens.GetHandle();
+	for (int frame = 0; frame < 60; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+	CHECK(moved == 0.0f && tweens.IsAlive(received));
+	CHECK(tweens.Resume(received));
+	tweens.Update(0.2f);
+	CHECK(moved == 0.0f);
+	for (int frame = 0; frame < 20; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+	CHECK(moved == 1.0f && !tweens.IsAlive(received));
+}
+
+// Pull mode finishes tweens from their start times, through Pause(), Seek(), groups and leaving it
+void TestPullTimers()
+{
+	STween::STween<float> tweens;
+	tweens.SetPullMode(true);
+	STween::TweenGroup group;
+	int finishes = 0;
+	float a = 0.0f;
+	float b = 0.0f;
+	float c = 0.0f;
+	tweens.From(&a).To(1.0f).Time(1.0f).OnFinish([&finishes] { ++finishes; });
+	const STween::TweenHandle first = tweens.GetHandle();
+	tweens.From(&b).To(1.0f).Time(0.5f).Group(&group).OnFinish([&finishes] { ++finishes; });
+	const STween::TweenHandle second = tweens.GetHandle();
+	tweens.From(&c).To(1.0f).Time(0.4f).Loop(2).OnFinish([&finishes] { ++finishes; });
+	const STween::TweenHandle third = tweens.GetHandle();
+
+	for (int frame = 0; frame < 30; ++frame)
+	{
+		if (frame == 15)
+			group.Pause();
+		tweens.Update(FrameTime);
+	}
+	float value = 0.0f;
+	CHECK(tweens.Sample(first, value) && std::fabs(value - 0.5f) < 1e-3f);
+	CHECK(tweens.Sample(second, value) && std::fabs(value - 0.5f) < 1e-3f);
+	CHECK(tweens.Sample(third, value) && std::fabs(value - 0.25f) < 1e-3f);
+	// Targets are only written once finished
+	CHECK(a == 0.0f && b == 0.0f && c == 0.0f);
+
+	// The looping tween ends after its second play, the paused one keeps its progress
+	tweens.Pause(first);
+	for (int frame = 0; frame < 30; ++frame)
+		tweens.Update(FrameTime);
+	CHECK(!tweens.IsAlive(third) && c == 1.0f && finishes == 1);
+	CHECK(tweens.Sample(first, value) && std::fabs(value - 0.5f) < 1e-3f);
+
+	// A sought tween finishes from its new start time once its group runs again
+	tweens.Resume(first);
+	tweens.Seek(second, 0.45f);
+	group.Resume();
+	for (int frame = 0; frame < 5; ++frame)
+		tweens.Update(FrameTime);
+	CHECK(!tweens.IsAlive(second) && b == 1.0f && finishes == 2);
+
+	// Leaving pull mode hands the progress back to Update()
+	CHECK(tweens.Sample(first, value) && std::fabs(value - (0.5f + 5 * FrameTime)) < 1e-3f);
+	tweens.SetPullMode(false);
+	float pushed = 0.0f;
+	CHECK(tweens.Sample(first, pushed) && pushed == value);
+	for (int frame = 0; frame < 30; ++frame)
+		tweens.Update(FrameTime);
+	CHECK(!tweens.IsAlive(first) && a == 1.0f && finishes == 3);
+	CHECK(tweens.Size() == 0);
+}
+
+// Retarget() keeping the velocity moves on at the speed it had, or starts over where the curve is flat
+void TestRetargetVelocity()
+{
+	const float step = 1.0e-3f;
+	STween::STween<float> tweens;
+	float value = 0.0f;
+	const STween::TweenHandle handle = tweens.From(&value).To(1.0f).Time(1.0f).Easing(STween::CubicInOut).GetHandle();
+	for (int frame = 0; frame < 24; ++frame)
+	{
+		tweens.Update(FrameTime);
+	}
+
+	// Speeds by finite difference over a short step on each side
+	float previous = 0.0f;
+	float current = 0.0f;
+	float next = 0.0f;
+	CHECK(tweens.Sample(handle, previous));
+	tweens.Update(step);
+	CHECK(tweens.Sample(handle, current));
+	CHECK(tweens.Retarget(handle, 4.0f, true));
+	float retargeted = 0.0f;
+	CHECK(tweens.Sample(handle, retargeted) && std::fabs(retargeted - current) < 1e-5f);
+	tweens.Update(step);
+	CHECK(tweens.Sample(handle, next));
+	const float before = (current - previous) / step;
+	const float after = (next - current) / step;
+	CHECK(before > 0.5f && std::fabs(after - before) < 0.01f * before);
+	// Three times as far at the same speed takes about three times longer than the 0.6 seconds it had left
+	const std::vector<STween::TweenData<float>> data = tweens.GetTweens();
+	CHECK(data.size() == 1 && data[0].duration > 2.0f);
+
+	// No speed to keep at the start of an ease in, it starts over
+	float flat = 0.0f;
+	const STween::TweenHandle started = tweens.From(&flat).To(1.0f).Time(0.5f).Easing(STween::CubicInOut).GetHandle();
+	CHECK(tweens.Retarget(started, 2.0f, true));
+	const std::vector<STween::TweenData<float>> restarted = tweens.GetTweens();
+	CHECK(restarted.size() == 2 && restarted[1].duration == 0.5f && restarted[1].timeCounter == 0.0f);
+}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1)
+	{
+		g_filter = argv[1];
+	}
+
+	Run("SpawnFromCallbacks", &TestSpawnFromCallbacks);
+	Run("SpawnFromDeferredCallbacks", &TestSpawnFromDeferredCallbacks);
+	Run("SpawnFromChainedCallbacks", &TestSpawnFromChainedCallbacks);
+	Run("SortedSeparateWrites", &TestSortedSeparateWrites);
+	Run("DeferredParallel", &TestDeferredParallel);
+	Run("PullLoops", &TestPullLoops);
+	Run("TicksLoops", &TestTicksLoops);
+	Run("DelayGroups", &TestDelayGroups);
+	Run("CopyDelayed", &TestCopyDelayed);
+	Run("RetargetYoyo", &TestRetargetYoyo);
+	Run("TimelineLoop", &TestTimelineLoop);
+	Run("CompactMatches", &TestCompactMatches);
+	Run("SnapshotMix", &TestSnapshotMix);
+	Run("WorldClock", &TestWorldClock);
+	Run("EasingCurves", &TestEasingCurves);
+	Run("StaleHandles", &TestStaleHandles);
+	Run("SharedSequences", &TestSharedSequences);
+	Run("ArenaCallbacks", &TestArenaCallbacks);
+	Run("ThreadPool", &TestThreadPool);
+	Run("StaticGroup", &TestStaticGroup);
+	Run("SampledEasing", &TestSampledEasing);
+	Run("CustomEasing", &TestCustomEasing);
+	Run("AddBatch", &TestAddBatch);
+	Run("SpliceView", &TestSpliceView);
+#ifdef STWEEN_STATS
+	Run("Stats", &TestStats);
+#endif
+	Run("TraitsLanes", &TestTraitsLanes);
+	Run("CoalesceRetarget", &TestCoalesceRetarget);
+	Run("TimelineSeek", &TestTimelineSeek);
+#ifdef STWEEN_COROUTINES
+	Run("Awaiters", &TestAwaiters);
+#endif
+	Run("SubmitQueue", &TestSubmitQueue);
+	Run("PauseDelayed", &TestPauseDelayed);
+	Run("PullTimers", &TestPullTimers);
+	Run("RetargetVelocity", &TestRetargetVelocity);
+
+	if (g_failures)
+	{
+		std::printf("%d check(s) failed\n", g_failures);
+	}
+	return g_failures;
+}